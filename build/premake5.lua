@@ -6,6 +6,16 @@ startproject("hidenseek-cmsc141_domingo-guarin-jumaya-putalan")
 
 outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 
+-- premake5 gmake2 --profile compiles in the PROFILE_SCOPE timing markers (see include/profiler.h)
+newoption({
+	trigger = "profile",
+	description = "Compile in the frame profiler: F3 toggles its overlay, F4 writes a Chrome trace",
+})
+
+filter("options:profile")
+defines({ "HIDENSEEK_PROFILE" })
+filter({})
+
 -- Include directories
 IncludeDir = {}
 IncludeDir["raylib"] = "/opt/homebrew/Cellar/raylib/5.5/include" -- IMPORTANT: Change this to your Raylib src path!
@@ -28,10 +38,31 @@ objdir("bin-int/" .. outputdir)
 files({
 	"../src/main.cpp",
 	"../src/player.cpp",
-	"../src/hider.cpp",
+	"../src/hider_batch.cpp",
 	"../src/game_manager.cpp",
 	"../src/ui_manager.cpp",
 	"../src/map.cpp",
+	"../src/map_render.cpp",
+	"../src/text_cache.cpp",
+	"../src/sdf_font.cpp",
+	"../src/asset_archive.cpp",
+	"../src/asset_loader.cpp",
+	"../src/sprite_atlas.cpp",
+	"../src/resource_cache.cpp",
+	"../src/profiler.cpp",
+	"../src/snapshot_ring.cpp",
+	"../src/replay.cpp",
+	"../src/keyboard_seeker_controller.cpp",
+	"../src/seeker_bot.cpp",
+	"../src/simulation.cpp",
+	"../src/thread_pool.cpp",
+	"../src/spatial_hash.cpp",
+	"../src/mapped_file.cpp",
+	"../src/map_file.cpp",
+	"../src/distance_field.cpp",
+	"../src/flee_field.cpp",
+	"../src/pathfinder.cpp",
+	"../src/collision_grid.cpp",
 	"../include/resource_dir.h", -- If it's compiled with the project
 })
 
@@ -85,3 +116,274 @@ symbols("On")
 filter("configurations:Release")
 defines("NDEBUG")
 optimize("On")
+
+-- Offline tool that bakes map layouts into the .hsmap files loaded by the game
+filter({})
+project("hidenseek-mapbake")
+kind("ConsoleApp")
+language("C++")
+cppdialect("C++17")
+staticruntime("off")
+
+targetdir("bin/" .. outputdir)
+objdir("bin-int/" .. outputdir .. "/mapbake")
+
+files({
+	"../tools/mapbake.cpp",
+	"../src/map.cpp",
+	"../src/map_file.cpp",
+	"../src/mapped_file.cpp",
+	"../src/distance_field.cpp",
+	"../src/pathfinder.cpp",
+	"../src/collision_grid.cpp",
+})
+
+includedirs({
+	"../include",
+	"%{IncludeDir.raylib}",
+})
+
+libdirs({
+	"%{LibDir.raylib}",
+})
+
+links({
+	"raylib",
+})
+
+filter("system:windows")
+systemversion("latest")
+defines({ "PLATFORM_DESKTOP" })
+links({ "opengl32", "gdi32", "winmm" })
+
+filter("system:linux")
+defines({ "PLATFORM_DESKTOP" })
+links({ "GL", "m", "pthread", "dl", "rt", "X11" })
+
+filter("system:macosx")
+defines({ "PLATFORM_DESKTOP" })
+buildoptions({ "-std=c++17" })
+linkoptions({
+	"-framework OpenGL",
+	"-framework Cocoa",
+	"-framework IOKit",
+	"-framework CoreAudio",
+	"-framework CoreVideo",
+})
+
+filter("configurations:Debug")
+defines("DEBUG")
+symbols("On")
+
+filter("configurations:Release")
+defines("NDEBUG")
+optimize("On")
+
+-- Offline tool that packs the resources directory into the .hspak archive loaded by the game
+filter({})
+project("hidenseek-assetpack")
+kind("ConsoleApp")
+language("C++")
+cppdialect("C++17")
+staticruntime("off")
+
+targetdir("bin/" .. outputdir)
+objdir("bin-int/" .. outputdir .. "/assetpack")
+
+files({
+	"../tools/assetpack.cpp",
+	"../src/asset_archive.cpp",
+	"../src/sdf_font.cpp",
+	"../src/mapped_file.cpp",
+})
+
+includedirs({
+	"../include",
+	"%{IncludeDir.raylib}",
+})
+
+libdirs({
+	"%{LibDir.raylib}",
+})
+
+links({
+	"raylib",
+})
+
+filter("system:windows")
+systemversion("latest")
+defines({ "PLATFORM_DESKTOP" })
+links({ "opengl32", "gdi32", "winmm" })
+
+filter("system:linux")
+defines({ "PLATFORM_DESKTOP" })
+links({ "GL", "m", "pthread", "dl", "rt", "X11" })
+
+filter("system:macosx")
+defines({ "PLATFORM_DESKTOP" })
+buildoptions({ "-std=c++17" })
+linkoptions({
+	"-framework OpenGL",
+	"-framework Cocoa",
+	"-framework IOKit",
+	"-framework CoreAudio",
+	"-framework CoreVideo",
+})
+
+filter("configurations:Debug")
+defines("DEBUG")
+symbols("On")
+
+filter("configurations:Release")
+defines("NDEBUG")
+optimize("On")
+
+-- Headless simulation: no window, GPU or audio, so it runs on machines without a display.
+-- raylib is only used for its headers (Vector2, Rectangle, raymath), nothing is linked from it.
+filter({})
+project("hidenseek-sim")
+kind("ConsoleApp")
+language("C++")
+cppdialect("C++17")
+staticruntime("off")
+
+targetdir("bin/" .. outputdir)
+objdir("bin-int/" .. outputdir .. "/sim")
+
+defines({ "HIDENSEEK_HEADLESS" })
+
+files({
+	"../tools/sim.cpp",
+	"../src/simulation.cpp",
+	"../src/replay.cpp",
+	"../src/player.cpp",
+	"../src/hider_batch.cpp",
+	"../src/map.cpp",
+	"../src/profiler.cpp",
+	"../src/thread_pool.cpp",
+	"../src/spatial_hash.cpp",
+	"../src/mapped_file.cpp",
+	"../src/map_file.cpp",
+	"../src/distance_field.cpp",
+	"../src/flee_field.cpp",
+	"../src/pathfinder.cpp",
+	"../src/collision_grid.cpp",
+})
+
+includedirs({
+	"../include",
+	"%{IncludeDir.raylib}",
+})
+
+filter("system:linux")
+links({ "m", "pthread" })
+
+filter("system:macosx")
+buildoptions({ "-std=c++17" })
+
+filter("configurations:Debug")
+defines("DEBUG")
+symbols("On")
+
+filter("configurations:Release")
+defines("NDEBUG")
+optimize("On")
+
+-- Parallel batch runner: plays many headless matches with a scripted seeker and writes a CSV of results.
+filter({})
+project("hidenseek-batch")
+kind("ConsoleApp")
+language("C++")
+cppdialect("C++17")
+staticruntime("off")
+
+targetdir("bin/" .. outputdir)
+objdir("bin-int/" .. outputdir .. "/batch")
+
+defines({ "HIDENSEEK_HEADLESS" })
+
+files({
+	"../tools/batch.cpp",
+	"../src/seeker_bot.cpp",
+	"../src/simulation.cpp",
+	"../src/player.cpp",
+	"../src/hider_batch.cpp",
+	"../src/map.cpp",
+	"../src/profiler.cpp",
+	"../src/thread_pool.cpp",
+	"../src/spatial_hash.cpp",
+	"../src/mapped_file.cpp",
+	"../src/map_file.cpp",
+	"../src/distance_field.cpp",
+	"../src/flee_field.cpp",
+	"../src/pathfinder.cpp",
+	"../src/collision_grid.cpp",
+})
+
+includedirs({
+	"../include",
+	"%{IncludeDir.raylib}",
+})
+
+filter("system:linux")
+links({ "m", "pthread" })
+
+filter("system:macosx")
+buildoptions({ "-std=c++17" })
+
+filter("configurations:Debug")
+defines("DEBUG")
+symbols("On")
+
+filter("configurations:Release")
+defines("NDEBUG")
+optimize("On")
+
+-- Microbenchmarks for the simulation hot paths, with JSON output for comparing runs.
+filter({})
+project("hidenseek-bench")
+kind("ConsoleApp")
+language("C++")
+cppdialect("C++17")
+staticruntime("off")
+
+targetdir("bin/" .. outputdir)
+objdir("bin-int/" .. outputdir .. "/bench")
+
+defines({ "HIDENSEEK_HEADLESS" })
+
+files({
+	"../tools/bench.cpp",
+	"../src/simulation.cpp",
+	"../src/player.cpp",
+	"../src/hider_batch.cpp",
+	"../src/map.cpp",
+	"../src/profiler.cpp",
+	"../src/thread_pool.cpp",
+	"../src/spatial_hash.cpp",
+	"../src/mapped_file.cpp",
+	"../src/map_file.cpp",
+	"../src/distance_field.cpp",
+	"../src/flee_field.cpp",
+	"../src/pathfinder.cpp",
+	"../src/collision_grid.cpp",
+})
+
+includedirs({
+	"../include",
+	"%{IncludeDir.raylib}",
+})
+
+filter("system:linux")
+links({ "m", "pthread" })
+
+filter("system:macosx")
+buildoptions({ "-std=c++17" })
+
+filter("configurations:Debug")
+defines("DEBUG")
+symbols("On")
+
+filter("configurations:Release")
+defines("NDEBUG")
+optimize("On")
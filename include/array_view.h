@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Read-only view over a contiguous array that lives somewhere else, either in a
+// std::vector owned by the caller or inside a memory-mapped file.
+// The view never owns or frees the data, so the storage must outlive it.
+template <typename T>
+struct ArrayView {
+    const T* data = nullptr;
+    size_t count = 0;
+
+    ArrayView() = default;
+    ArrayView(const T* viewData, size_t viewCount) : data(viewData), count(viewCount) {}
+    ArrayView(const std::vector<T>& storage) : data(storage.data()), count(storage.size()) {}
+
+    const T& operator[](size_t index) const { return data[index]; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "raylib.h"
+#include "mapped_file.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Packed .hspak resources, written by hidenseek-assetpack. The file is memory-mapped and the
+// loaders read straight out of the mapping, so opening it costs one file probe however many
+// assets it holds. Entries keep the name of the file they were packed from (images too, even
+// though they are re-encoded), so lookups use the same paths as the loose files.
+const uint32_t ASSET_ARCHIVE_MAGIC = 0x4B415048; // "HPAK"
+const uint32_t ASSET_ARCHIVE_VERSION = 1;
+const uint32_t ASSET_ARCHIVE_ALIGNMENT = 16;
+const int ASSET_ARCHIVE_NAME_LENGTH = 48;
+
+enum class AssetEncoding : uint32_t {
+    STORED, // The original file's bytes, decoded by its extension
+    QOI,    // Image re-encoded as QOI, which decodes several times faster than PNG
+    RGBA8   // Image as raw R8G8B8A8 pixels, nothing to decode
+};
+
+struct AssetArchiveEntry {
+    char name[ASSET_ARCHIVE_NAME_LENGTH]; // NUL-terminated; entries are sorted by name
+    uint32_t encoding; // AssetEncoding
+    int32_t width; // Images only
+    int32_t height;
+    uint32_t reserved;
+    uint64_t offset; // From the start of the file, aligned to ASSET_ARCHIVE_ALIGNMENT
+    uint64_t size;
+};
+
+struct AssetArchiveHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t entriesOffset; // AssetArchiveEntry
+    uint64_t entryCount;
+};
+
+// One asset for Write, already encoded
+struct AssetArchiveInput {
+    std::string name;
+    AssetEncoding encoding;
+    int width;
+    int height;
+    std::vector<unsigned char> data;
+};
+
+class AssetArchive {
+public:
+    AssetArchive();
+    bool Open(const char* path); // Maps the file and validates the header and entries
+    void Close();
+    bool IsOpen() const { return entries != nullptr; }
+
+    const AssetArchiveEntry* Find(const char* name) const; // nullptr if it isn't packed
+    const unsigned char* GetData(const AssetArchiveEntry& entry) const { return file.data + entry.offset; }
+
+    // Packed first, then the loose file, so an unpacked resources directory still works.
+    // Safe to call from several threads at once, except ReadFont, which uploads its atlas.
+    // Fonts are SDF fonts (see sdf_font.h); BakeFont is the part without the upload.
+    bool Exists(const char* path) const;
+    Image ReadImage(const char* path) const;
+    Wave ReadWave(const char* path) const;
+    bool BakeFont(const char* path, Font& font, Image& atlas) const;
+    Font ReadFont(const char* path) const;
+    Music OpenMusic(const char* path) const; // A packed stream reads from the mapping, so it must be unloaded before Close
+
+    static bool Write(std::vector<AssetArchiveInput>& inputs, const char* path); // Sorts inputs by name
+
+private:
+    MappedFile file;
+    const AssetArchiveEntry* entries;
+    size_t entryCount;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "raylib.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class ResourceCache;
+
+enum class AssetKind : uint8_t {
+    TEXTURE,
+    SOUND,
+    FONT
+};
+
+// Decodes images, sounds and fonts on worker threads, so startup isn't one long stall on the
+// main thread. Request queues a file under a group number. Update, called every frame on the
+// main thread, does the part that needs the GL context or the audio device (the upload) for
+// whatever has finished decoding, and inserts the result into the ResourceCache. The loader
+// keeps that reference until the group is released, so owners that Acquire the same paths in
+// the meantime get the loaded asset straight away. A group can be requested again after it
+// has been released and unloaded.
+//
+// Music streams aren't loaded here: LoadMusicStream only opens the file, and the decoding
+// happens a chunk at a time while the music plays.
+class AssetLoader {
+public:
+    explicit AssetLoader(ResourceCache& resources, int workerCount = -1); // -1: one per core but the main thread's
+    ~AssetLoader(); // Lets each worker finish its current file, drops the rest, and releases what it holds
+
+    void Request(AssetKind kind, const char* path, int group);
+    void Update();
+    bool IsGroupReady(int group) const; // Everything requested under group is in the cache, or missing
+    float GetProgress(int group) const; // Fraction of the group's requests done
+    void ReleaseGroup(int group); // Once the owners have acquired their own references
+    void ReleaseAll();
+
+private:
+    struct Job {
+        AssetKind kind;
+        std::string path;
+        int group;
+        // Decoded by the worker; all empty if the file is missing or unreadable
+        Image image; // The texture, or the font's glyph atlas
+        Wave wave;
+        Font font; // Glyphs only, the texture is uploaded from image
+    };
+
+    ResourceCache& resources;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeWorkers;
+    std::deque<Job> queued; // Waiting for a worker
+    std::vector<Job> decoded; // Waiting for Update
+    bool stopping;
+
+    // Main thread only
+    std::vector<int> requestedPerGroup;
+    std::vector<int> donePerGroup;
+    // References held until release, each with its group
+    std::vector<std::pair<int, Texture2D>> heldTextures;
+    std::vector<std::pair<int, Sound>> heldSounds;
+    std::vector<std::pair<int, Font>> heldFonts;
+
+    void WorkerLoop();
+    void Decode(Job& job) const;
+    static void FreeDecoded(Job& job);
+};
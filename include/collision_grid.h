@@ -0,0 +1,34 @@
+#pragma once
+
+#include "raylib.h"
+#include "array_view.h"
+#include <vector>
+#include <cstdint>
+
+// One-bit-per-pixel occupancy grid baked from the map obstacles for a single entity radius.
+// A set bit means an entity of that radius centred on the pixel would be inside an
+// obstacle (obstacles are expanded by radius + COLLISION_SAFETY_MARGIN while baking).
+class CollisionGrid {
+public:
+    float radius;
+    int width;        // in cells, one cell per pixel
+    int height;
+    int wordsPerRow;
+    ArrayView<uint64_t> bits; // Points into storage after Bake, or into a mapped map file after Attach
+
+    CollisionGrid();
+    void Bake(ArrayView<Rectangle> obstacles, float entityRadius, int worldWidth, int worldHeight);
+    void Attach(float entityRadius, int gridWidth, int gridHeight, ArrayView<uint64_t> bakedBits);
+
+    bool IsBlocked(Vector2 position) const {
+        int cx = (int)position.x;
+        int cy = (int)position.y;
+        if (position.x < 0 || position.y < 0 || cx >= width || cy >= height) return false; // Bounds are checked by the caller
+        return (bits[cy * wordsPerRow + (cx >> 6)] >> (cx & 63)) & 1ULL;
+    }
+
+private:
+    std::vector<uint64_t> storage;
+
+    void FillRect(int x0, int y0, int x1, int y1); // Half-open cell range [x0, x1) x [y0, y1)
+};
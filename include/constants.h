@@ -1,6 +1,7 @@
 #pragma once
 
 #include "raylib.h"
+#include <cstddef> // For size_t
 
 // Screen Dimensions
 const int SCREEN_WIDTH = 1280;
@@ -9,6 +10,14 @@ const int SCREEN_HEIGHT = 720;
 // Game Title
 inline const char* GAME_TITLE = "State of Fear: Ryan's Revenge";
 
+// Baked map layout, relative to the resources directory
+inline const char* MAP_FILE_PATH = "map.hsmap";
+inline const char* ASSET_ARCHIVE_PATH = "assets.hspak"; // Packed textures, sounds and fonts, if hidenseek-assetpack was run
+const size_t ASSET_BUDGET_BYTES = 64 * 1024 * 1024; // Loaded textures and sounds kept before unused screens' are evicted
+const bool ASSET_PREFETCH = true; // Load the likely next screen's assets ahead of the transition
+inline const char* REPLAY_DIRECTORY = "replays"; // Every finished match is saved here as <seed>.hsreplay
+inline const char* FONT_CACHE_DIRECTORY = "fontcache"; // Baked SDF font atlases, see sdf_font.h
+
 // Player Constants
 const float PLAYER_SPEED = 120.0f;
 const float PLAYER_SPRINT_SPEED = 240.0f;
@@ -19,6 +28,7 @@ const float SPRINT_MAX = 100.0f;
 const float SPRINT_DEPLETE_RATE = 50.0f; // per second
 const float SPRINT_REGEN_RATE = 15.0f;   // per second
 const float TAG_RANGE = 50.0f; // How close player needs to be within cone to tag
+const float TAG_POSE_DURATION = 0.25f; // Seconds the seeker shows its tag sprite after tagging
 
 // Hider Constants
 const float HIDER_SPEED = 120.0f;
@@ -28,8 +38,24 @@ const float HIDER_VISION_RADIUS = 150.0f;
 const float HIDER_ATTACK_COOLDOWN = 3.0f; // seconds
 const float HIDER_ATTACK_RANGE = 30.0f;
 const int NUM_HIDERS = 5;
+const int HIDER_SKIN_COUNT = 5; // hider_stand.png plus hider1..4_stand.png, reused round-robin
+const int HIDER_MAX_PATH_POINTS = 32; // Waypoint slots per hider
+const int HIDER_UPDATE_MIN_CHUNK = 64; // Fewer hiders than this in a state are updated on the calling thread
+
+// Collision Constants
+const float COLLISION_SAFETY_MARGIN = 5.0f; // Extra clearance kept around every obstacle
+const float SDF_CELL_SIZE = 2.0f; // Pixels per distance field sample
+
+// Navigation Constants
+const int NAV_CELL_SIZE = 16; // Pixels per pathfinding grid cell
+const float FLEE_FIELD_COEFFICIENT = 1.2f; // How strongly the inverted flee map prefers distance over escape routes
+const float SPATIAL_HASH_CELL_SIZE = 64.0f; // Pixels per bucket for hider proximity queries
+const int SEEKER_BOT_REPLAN_TICKS = 15; // Scripted seeker recomputes its path to the target this often
+const float SEEKER_BOT_WAYPOINT_RADIUS = 8.0f; // Scripted seeker moves on once this close to a waypoint
+const float SEEKER_BOT_SPOT_CHECKED_RADIUS = 40.0f; // Sweeping seeker counts a hiding spot as checked from this close
+const int SEEKER_BOT_SPOT_GIVE_UP_TICKS = 600; // ...or after walking towards it this long without getting there
 
-// Hiding Spot Constants (as proportions of 1280x720)
+// Hiding Spot Constants for the built-in layout (as proportions of 1280x720)
 #define HSP(x, y) {(x) * SCREEN_WIDTH / 1280.0f, (y) * SCREEN_HEIGHT / 720.0f}
 
 const Vector2 HIDING_SPOT_BUSH_G1 = HSP(166, 225);
@@ -54,12 +80,15 @@ const Vector2 HIDING_SPOT_PLANT = HSP(664, 282);
 // Game Time
 const float HIDING_PHASE_DURATION = 10.0f; // seconds for hiders to hide
 const float SEEKING_PHASE_DURATION = 120.0f; // 2 minutes for seeker
+const float SIM_TICK_RATE = 60.0f; // Simulation ticks per second, independent of the render frame rate
+const int SIM_MAX_TICKS_PER_FRAME = 5; // Time beyond this after a hitch is dropped instead of caught up
+const int SNAPSHOT_RING_CAPACITY = 600; // Ticks of rewind kept while playing, 10 seconds at SIM_TICK_RATE
 
 // Colors
 const Color PLAYER_COLOR = BLUE;
 const Color HIDER_COLOR = GREEN;
 const Color HIDER_TAGGED_COLOR = LIGHTGRAY;
-const Color VISION_CONE_COLOR = Fade(WHITE, 0.8f);
+const Color VISION_CONE_COLOR = {255, 255, 255, 204}; // WHITE at 80%, spelled out so headless builds need no raylib functions
 const Color ALERT_COLOR = RED;
 
 // UI
@@ -76,6 +105,14 @@ const int PAUSE_MENU_TITLE_FONT_SIZE = 50;
 const int GAME_OVER_TITLE_FONT_SIZE = 100;
 const int GAME_OVER_REASON_FONT_SIZE = 40;
 
+// Character sprite atlas
+const int SPRITE_ATLAS_MIN_SIZE = 256; // Width the packer starts from, doubled until the sprites fit
+const int SPRITE_ATLAS_PADDING = 2; // Empty pixels between sprites, so filtering never reads a neighbour
+
+// Static map layer
+const int MAP_LAYER_CHUNK_SIZE = 2048; // Largest render texture the map is composited into; bigger maps are tiled
+
+#ifndef HIDENSEEK_HEADLESS // Computed by raylib functions, and only the UI needs them
 const Color TEXT_COLOR = WHITE;
 const Color BUTTON_COLOR = GetColor(0xAF3800FF);
 const Color BUTTON_HOVER_COLOR = GetColor(0xE86A17FF);
@@ -90,6 +127,7 @@ const Color PAUSE_MENU_TEXT_COLOR = WHITE;
 const Color GAME_OVER_WIN_COLOR = GetColor(0xFFCF56FF);
 const Color GAME_OVER_LOSS_COLOR = GetColor(0xAF3800FF);
 const Color GAME_OVER_REASON_TEXT_COLOR = WHITE;
+#endif
 
 // Alert symbol
 const float ALERT_BEHIND_DISTANCE = 100.0f;
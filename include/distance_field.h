@@ -0,0 +1,29 @@
+#pragma once
+
+#include "raylib.h"
+#include "array_view.h"
+#include <vector>
+
+// Signed distance from the nearest obstacle edge (or world border), baked at load time.
+// Positive in free space, negative inside obstacles. Sampled on a grid of cell centres
+// and bilinearly interpolated, so values are accurate to about a cell.
+class DistanceField {
+public:
+    float cellSize;
+    int cols;
+    int rows;
+    ArrayView<float> distance;  // Point into the storage below after Bake, or into a mapped map file after Attach
+    ArrayView<Vector2> gradient; // Unit direction of increasing distance, per cell
+
+    DistanceField();
+    void Bake(ArrayView<Rectangle> obstacles, int worldWidth, int worldHeight, float resolution);
+    void Attach(float resolution, int fieldCols, int fieldRows, ArrayView<float> bakedDistance, ArrayView<Vector2> bakedGradient);
+    float Sample(Vector2 position) const;
+    Vector2 SampleGradient(Vector2 position) const;
+
+private:
+    std::vector<float> distanceStorage;
+    std::vector<Vector2> gradientStorage;
+
+    void ComputeGradients();
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "raylib.h"
+#include <vector>
+
+class Pathfinder; // Forward declaration
+
+// Dijkstra flee map over the navigation grid, shared by every evading hider.
+// Distances from the seeker are inverted and rescanned so that following the
+// field downhill leads away from the seeker and out of dead ends.
+class FleeField {
+public:
+    int sourceCell; // Nav cell the seeker was in when the field was last updated
+    std::vector<int> distance; // Path cost from the seeker
+    std::vector<int> fleeCost; // Inverted and rescanned cost, lower is safer
+    std::vector<int> nextCell; // Cheapest neighbour per cell, -1 at local minima
+
+    FleeField();
+    void Reset();
+    void Update(const Pathfinder& navGrid, Vector2 seekerPosition); // Only does work when the seeker changes cell
+    Vector2 GetDirection(const Pathfinder& navGrid, Vector2 position) const;
+
+private:
+    struct QueueNode {
+        int cost;
+        int cell;
+        bool operator<(const QueueNode& other) const { return cost > other.cost; } // Min-heap on cost
+    };
+    std::vector<QueueNode> queue;
+
+    void Relax(const Pathfinder& navGrid, std::vector<int>& costs);
+    void BuildNextCells(const Pathfinder& navGrid);
+};
@@ -2,22 +2,70 @@
 
 #include "raylib.h"
 #include "game_state.h"
-#include "player.h"
-#include "hider.h"
-#include "map.h"
+#include "simulation.h"
+#include "thread_pool.h"
 #include "ui_manager.h"
+#include "sim_clock.h"
+#include "keyboard_seeker_controller.h"
+#include "seeker_bot.h"
+#include "replay.h"
+#include "snapshot_ring.h"
+#include "resource_cache.h"
+#include "asset_loader.h"
+#include "sprite_atlas.h"
+#include "profiler.h"
 #include <vector>
 
+// Assets loaded and unloaded together: what every screen uses, then one group per screen
+// that draws something of its own (the pause menu draws over the game, so it shares IN_GAME's)
+enum class AssetGroup {
+    SHARED,
+    MAIN_MENU,
+    HOW_TO_PLAY,
+    IN_GAME,
+    GAME_OVER,
+    COUNT
+};
+
+enum class AssetGroupState {
+    UNLOADED,
+    LOADING, // Requested from the AssetLoader, still decoding
+    LOADED
+};
+
+struct AssetGroupStatus {
+    AssetGroupState state;
+    double lastUsed; // GetTime() when its screen was last entered, for eviction
+};
+
 class GameManager {
 public:
     GameScreen currentScreen;
-    GamePhase currentPhase;
+    GameScreen screenAfterLoading; // Where LOADING goes once the assets it waits for are in
+    GameScreen shownScreen; // currentScreen as of the last check, to notice transitions
 
-    Player player;
-    std::vector<Hider> hiders;
-    Map gameMap;
+    ResourceCache resources; // Map and UI textures and every sound below come from here
+    AssetLoader assetLoader; // Decodes them in the background, a screen's worth at a time
+    AssetGroupStatus assetGroups[(int)AssetGroup::COUNT];
+    size_t assetBudget; // Cache size in bytes past which the least recently shown screens' assets are unloaded
+    bool prefetchAssets; // Start loading the likely next screen's assets on entering a screen
+    SpriteAtlas characterAtlas; // Seeker and hider sprites, packed into one texture
+    SpriteBatch characterSprites;
+    Simulation sim; // The match itself; everything here is presentation around it
+    ThreadPool threadPool; // Workers for the hider update
     UIManager uiManager;
     Camera2D camera; // Camera that follows the player
+    SimClock simClock; // The game simulates in fixed ticks, drawing interpolates between them
+    float renderAlpha; // Fraction of a tick the current frame is past the last one
+    KeyboardSeekerController keyboardSeeker;
+    SeekerBot seekerBot; // Plays the seeker instead of the keyboard when toggled with F2
+    ReplaySeekerController replaySeeker;
+    SeekerController* seeker; // Whichever of these is playing
+    Replay replay; // Recording of the current match, or the match being played back
+    bool playingReplay;
+    float playbackSpeed; // Simulated seconds per real second while playing a replay
+    SnapshotRing rewindBuffer; // The last few seconds of the match, popped while Backspace is held
+    std::vector<unsigned char> saveState; // Quick save (F5) of the current match, loaded with F9
     RenderTexture2D visionOverlay; // For vision circle effect
     Music hidingPhaseMusic; // Music for hiding phase
     Music seekingPhaseMusic; // Music for seeking phase
@@ -27,28 +75,39 @@ public:
     Sound seekerFootsteps;
     Sound hiderFootsteps;
 
-    float gameTimer; // Used for both hiding and seeking phases
-    float hidingPhaseElapsed;
-    int hidersRemaining;
-    bool playerWon;
-    float lastGameTime; // To display on game over
-
     bool quitGame; // Flag to exit game loop
     bool restartGameFlag; // Flag to re-initialize game
+#ifdef HIDENSEEK_PROFILE
+    bool showProfiler; // Profiler overlay, toggled with F3
+#endif
 
     GameManager();
     ~GameManager();
 
     void InitGame(); // Initializes/Resets the game state for a new round
+    void InitGame(uint64_t seed); // Same, with a given match seed so a match can be reproduced
+    bool StartReplay(const char* path, float speed); // Watch a saved match instead of playing one
     void Update();
     void Draw();
 
 private:
+    void UpdateLoading(); // Picks up decoded asset groups, on every screen
+    void CheckScreenChange(); // Sends a screen whose assets aren't in yet through LOADING, and prefetches
+    bool IsScreenReady(GameScreen screen) const;
+    void RequestAssetGroup(AssetGroup group); // Starts decoding it unless it is loaded or loading
+    void LoadAssetGroup(AssetGroup group); // The owners acquire it once decoded
+    void UnloadAssetGroup(AssetGroup group);
+    void EvictAssets(); // Unloads least recently used groups until the cache fits assetBudget
+    size_t GetResidentAssetBytes() const; // The cache plus the map's composited layer, which lives outside it
     void UpdateMainMenu();
     void UpdateHowToPlay();
     void UpdateInGame();
+    void EndMatch(); // Game over screen and sounds once the simulation has a result
+    void SaveReplay();
+    void OnWorldRestored(GamePhase phaseBefore); // Brings input, replay and music in line after a rewind or quick load
     void UpdatePauseMenu();
     void UpdateGameOver();
+    void UpdateProfiler(); // F3 and F4, on every screen
 
     void DrawMainMenu();
     void DrawHowToPlay();
@@ -56,9 +115,5 @@ private:
     void DrawPauseMenu();
     void DrawGameOver();
 
-    void CheckWinLossConditions(bool playerGotTagged);
-    void ResetGameValues();
-    void StartHidingPhase();
-    void StartSeekingPhase();
 };
 
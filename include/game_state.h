@@ -1,6 +1,7 @@
 #pragma once
 
 enum class GameScreen {
+    LOADING,
     MAIN_MENU,
     HOW_TO_PLAY,
     IN_GAME,
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "raylib.h"
+#include "constants.h"
+#include "game_state.h" // For GamePhase
+#include "random.h"
+#include "sim_arena.h"
+#include <vector>
+#include <cstdint>
+
+// Forward declarations
+class Player;
+class Map;
+class FleeField;
+class SpatialHash;
+class ThreadPool;
+class SpriteAtlas;
+class SpriteBatch;
+
+enum class HiderHidingFSMState : uint8_t {
+    SCOUTING,
+    MOVING_TO_HIDING_SPOT,
+    HIDING
+};
+
+enum class HiderSeekingFSMState : uint8_t {
+    IDLING,
+    EVADING,
+    ATTACKING
+};
+
+// The part of every hider that the rest of the game can see: other hiders (through the
+// spatial hash), the player and the renderer. HiderBatch keeps two of these and swaps them
+// every tick, so an update only ever reads the previous tick's state, and drawing can
+// interpolate between the last two ticks.
+struct HiderState {
+    ArraySpan<Vector2> position;
+    ArraySpan<float> rotation; // in degrees
+    ArraySpan<uint8_t> isTagged;
+    ArraySpan<HiderHidingFSMState> hidingState;
+    ArraySpan<HiderSeekingFSMState> seekingState;
+    ArraySpan<Vector2> targetHidingSpot;
+
+    void Allocate(SimArena& arena, int count);
+    void Reset(); // Every hider back to its defaults
+    void CopyFrom(const HiderState& other);
+};
+
+// The scalar part of HiderBatch, kept apart so a world snapshot can copy it as one block
+struct HiderBatchState {
+    int count;
+    uint64_t matchSeed; // Keys every hider's random stream
+    float attackCooldown; // Seconds after landing a tag before a hider can attack again
+    int tagEvents; // Times a hider tagged the player during the last Update
+    float simTime; // Seconds simulated since Resize, drives the time-based evasion patterns
+    int frontBuffer; // Which of the two HiderStates holds the last completed tick
+
+    HiderBatchState() : count(0), matchSeed(0), attackCooldown(HIDER_ATTACK_COOLDOWN), tagEvents(0), simTime(0.0f), frontBuffer(0) {}
+};
+
+// Every hider in the match, stored as parallel arrays indexed by hider id (structure of arrays).
+// Update runs one FSM state at a time over the hiders currently in it, so each pass walks
+// the arrays it needs in order instead of hopping between fat per-hider objects.
+//
+// Within a pass each hider writes only its own slot of the back buffer and its own private
+// arrays, so passes are split across the thread pool; anything that crosses hiders (spot
+// claims, tagging the player) is applied afterwards in hider order. The result does not
+// depend on the thread count or on the order hiders are processed in.
+//
+// Every per-hider array, both state buffers included, lives in one SimArena, so the whole
+// batch is HiderBatchState plus arena bytes.
+class HiderBatch : public HiderBatchState {
+public:
+    ThreadPool* threadPool; // Set by GameManager; updates run serially without one
+    SimArena arena;
+
+    // Private per-hider state, only read and written by the hider it belongs to
+    ArraySpan<float> speed;
+    ArraySpan<float> timeSinceLastTag;
+    ArraySpan<float> timeSinceLastPlayerMovement;
+    ArraySpan<Vector2> lastPlayerPosition;
+    ArraySpan<float> attackCooldownTimer;
+    ArraySpan<float> randomMovementTimer; // Wandering while no hiding spot is free
+    ArraySpan<Vector2> randomMovementDirection;
+    ArraySpan<float> idleAlertTimer;  // Time spent near an alerted player while idling
+    ArraySpan<float> evadeAlertTimer; // Same while evading
+    ArraySpan<RandomStream> random;   // Keyed by match seed and hider index, so draws don't depend on update order
+    ArraySpan<uint8_t> claimedSpot;   // Claimed a hiding spot this tick, checked against other claims afterwards
+    ArraySpan<uint8_t> taggedPlayer;  // Reached the player this tick
+
+    // Cached paths, HIDER_MAX_PATH_POINTS slots per hider, only recomputed when the goal moves to a different nav cell
+    ArraySpan<Vector2> pathPoints;
+    ArraySpan<int> pathLength;
+    ArraySpan<int> pathIndex;
+    ArraySpan<int> pathGoalCell;
+
+    // Match statistics
+    ArraySpan<int> tagsLanded; // Times each hider tagged the player since Resize
+    ArraySpan<float> taggedAt; // Seeking time when the seeker tagged each hider, -1 if it never was
+
+    HiderBatch();
+    void Resize(int hiderCount, uint64_t seed); // Every hider back to its defaults
+    void Spawn(int i, Vector2 startPos);
+#ifndef HIDENSEEK_HEADLESS
+    void LoadSkins(SpriteAtlas& atlas); // Adds the skins to the atlas, which has to be built before drawing
+    void Draw(float alpha, SpriteBatch& sprites) const; // Interpolated between the last two ticks; alpha is the fraction of a tick since the last Update
+#endif
+    void Update(float deltaTime, GamePhase currentPhase, Player& player, const Map& gameMap, SpatialHash& hiderHash, const FleeField& fleeField);
+    int CountRemaining() const;
+    HiderState& Front() { return buffers[frontBuffer]; } // Last completed tick
+    const HiderState& Front() const { return buffers[frontBuffer]; }
+    void AddToSpatialHash(int i, SpatialHash& hiderHash) const { AddToSpatialHash(Front(), i, hiderHash); }
+
+    // Pure checks, public so the benchmarks can call them on their own
+    static bool IsInVision(const HiderState& s, int i, Vector2 targetPos);
+    static bool IsSpotTaken(int i, Vector2 spot, const SpatialHash& hiderHash, const Player& player);
+
+private:
+    HiderState buffers[2];
+
+    // Atlas frames per skin, -1 if the file was missing; hider i wears skin i % HIDER_SKIN_COUNT
+    int standSkins[HIDER_SKIN_COUNT];
+    int attackSkins[HIDER_SKIN_COUNT];
+
+    std::vector<int> stateGroups[3]; // Hider indices per FSM state, rebuilt at the start of each pass
+
+    HiderState& Back() { return buffers[1 - frontBuffer]; } // Tick being computed, then the previous tick after the swap
+    void LayoutArrays(); // Hands out every per-hider array from the arena for the current count
+    template <typename State>
+    void BuildStateGroups(ArraySpan<State> states);
+    template <typename Body>
+    void ForEachInGroup(int group, Body body);
+    bool FollowPath(HiderState& s, int i, Vector2 goal, float stepDistance, const Map& gameMap);
+    static void AddToSpatialHash(const HiderState& s, int i, SpatialHash& hiderHash);
+    static Vector2 GetForwardVector(const HiderState& s, int i);
+    bool CanAttack(const HiderState& s, int i, const Player& player) const;
+
+    // Hiding Phase FSM Logic
+    void UpdateHidingPhase(float deltaTime, const Map& gameMap, const Player& player, SpatialHash& hiderHash);
+    void Scout(HiderState& s, int i, float deltaTime, const Map& gameMap, const Player& player, const SpatialHash& hiderHash);
+    void MoveToHidingSpot(HiderState& s, int i, float deltaTime, const Map& gameMap);
+    void ResolveClaims(SpatialHash& hiderHash);
+
+    // Seeking Phase FSM Logic
+    void UpdateSeekingPhase(float deltaTime, Player& player, const Map& gameMap, const FleeField& fleeField);
+    void Idle(HiderState& s, int i, float deltaTime, const Player& player, const Map& gameMap);
+    void Evade(HiderState& s, int i, float deltaTime, const Player& player, const Map& gameMap, const FleeField& fleeField);
+    void AttemptTag(HiderState& s, int i, float deltaTime, const Map& gameMap, const Player& player);
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "seeker_controller.h"
+
+// The human seeker. Presses only show up for one frame but a frame can run zero ticks,
+// so Poll latches them every frame and NextInput consumes them on the next tick.
+class KeyboardSeekerController : public SeekerController {
+public:
+    KeyboardSeekerController();
+    void Reset() override;
+    void Poll(); // Once per frame
+    SeekerInput NextInput(const Simulation& sim) override;
+
+private:
+    bool skipHidingRequested;
+    bool tagRequested;
+};
@@ -1,26 +1,75 @@
 #pragma once
 
 #include "raylib.h"
+#include "collision_grid.h"
+#include "pathfinder.h"
+#include "distance_field.h"
+#include "map_file.h"
+#include "array_view.h"
+#include "random.h"
 #include <vector>
 
+class ResourceCache;
+class AssetLoader;
+
 class Map {
 public:
     Texture2D background;
     Texture2D wallTexture;
     Texture2D objTexture;
     Texture2D interior;
-    std::vector<Rectangle> obstacles; // Simple rectangular obstacles
-    std::vector<Vector2> hidingSpots;
+    // Background, interior and walls drawn once into render textures, in a grid of
+    // MAP_LAYER_CHUNK_SIZE chunks, row by row; one chunk unless the map is bigger than that
+    std::vector<RenderTexture2D> staticLayer;
+    int staticLayerColumns;
+    bool showObstacles; // Debug: draw the collision rectangles over the map
+    uint64_t layoutHash; // Hash of the layout and its collision/nav settings, however it was loaded; replays record it
+    int width;  // World size in pixels
+    int height;
+    ArrayView<Rectangle> obstacles; // Simple rectangular obstacles
+    ArrayView<Vector2> hidingSpots;
+    ArrayView<Vector2> spawnPoints; // Candidate player spawns
+    std::vector<CollisionGrid> collisionGrids; // Baked per entity radius
+    Pathfinder pathfinder; // Navigation grid for hider movement
+    DistanceField distanceField; // Clearance from the walls
 
     Map();
-    void Load();
-    void Unload();
+    Map(const Map&) = delete; // The views above point into this map's own storage
+    Map& operator=(const Map&) = delete;
+    void Load(); // Layout only, from MAP_FILE_PATH or the built-in fallback
+    bool LoadLayout(const char* path); // View over a baked .hsmap file, false if it is missing or invalid
+    void BuildLayout(int worldWidth, int worldHeight, const std::vector<Rectangle>& layoutObstacles,
+                     const std::vector<Vector2>& layoutHidingSpots, const std::vector<Vector2>& layoutSpawnPoints);
+    void BuildDefaultLayout(); // The built-in house layout, used when no map file is present
+#ifndef HIDENSEEK_HEADLESS // In map_render.cpp, which only the game builds
+    void RequestTextures(AssetLoader& loader, int group); // Decode ahead; LoadTextures then finds them cached
+    void LoadTextures(ResourceCache& resources); // Composites the static layer and releases its sources
+    void Unload(ResourceCache& resources);
     void Draw();
-    void DrawBaseAndWalls(); // Draw background and walls
+    void DrawBaseAndWalls(); // Draw background and walls, from the static layer
     void DrawObjects(const Vector2& playerPos); // Draw object texture (hiding spots) with transparency based on player position
-    bool IsPositionValid(Vector2 position, float radius) const; // Basic bounds check for now
-    Vector2 GetRandomHidingSpot() const;
-    const std::vector<Vector2>& GetHidingSpots() const { return hidingSpots; }
-    void InitHidingSpots();
+    size_t GetResidentBytes() const; // GPU memory held by the static layer, which isn't in the ResourceCache
+#endif
+    bool IsPositionValid(Vector2 position, float radius) const; // Bounds check + baked obstacle lookup
+    Vector2 GetRandomHidingSpot(RandomStream& random) const;
+    ArrayView<Vector2> GetHidingSpots() const { return hidingSpots; }
+    const Pathfinder& GetPathfinder() const { return pathfinder; }
+    float GetClearance(Vector2 position) const { return distanceField.Sample(position); } // Distance to the nearest wall
+    Vector2 GetGradient(Vector2 position) const { return distanceField.SampleGradient(position); } // Direction away from it
+    void BakeCollisionGrids();
+
+private:
+    MapFile mapFile;
+    // Owned layout for maps built in memory; empty while viewing a map file
+    std::vector<Rectangle> obstacleStorage;
+    std::vector<Vector2> hidingSpotStorage;
+    std::vector<Vector2> spawnPointStorage;
+
+    const CollisionGrid* FindCollisionGrid(float radius) const;
+    void ComputeLayoutHash();
+#ifndef HIDENSEEK_HEADLESS
+    void BuildStaticLayer();
+    void UnloadStaticLayer();
+#endif
 };
 
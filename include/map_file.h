@@ -0,0 +1,87 @@
+#pragma once
+
+#include "raylib.h"
+#include "array_view.h"
+#include "mapped_file.h"
+#include <cstdint>
+#include <cstddef> // For size_t
+
+class Map; // Forward declaration
+
+// Baked .hsmap layout. The file is memory-mapped and used in place, so every section
+// is a byte offset from the start of the file plus an element count, aligned to
+// MAP_FILE_ALIGNMENT. Values are stored in the native (little-endian) layout of the
+// raylib structs they hold.
+const uint32_t MAP_FILE_MAGIC = 0x50414D48; // "HMAP"
+const uint32_t MAP_FILE_VERSION = 1;
+const uint32_t MAP_FILE_ALIGNMENT = 16;
+const uint64_t MAP_HASH_SEED = 14695981039346656037ull; // FNV-1a offset basis
+
+// FNV-1a, for telling maps apart: continues hash over size more bytes
+inline uint64_t HashMapBytes(const void* data, size_t size, uint64_t hash = MAP_HASH_SEED) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+struct MapFileSection {
+    uint64_t offset;
+    uint64_t count;
+};
+
+struct MapFileCollisionGrid {
+    float radius;
+    int32_t width;
+    int32_t height;
+    int32_t wordsPerRow;
+    MapFileSection bits; // uint64_t
+};
+
+struct MapFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    int32_t worldWidth;
+    int32_t worldHeight;
+
+    MapFileSection obstacles;      // Rectangle
+    MapFileSection hidingSpots;    // Vector2
+    MapFileSection spawnPoints;    // Vector2, player spawn candidates
+
+    // Baked data, only used when the bake settings still match the game's constants
+    float collisionSafetyMargin;
+    int32_t navCellSize;
+    int32_t navCols;
+    int32_t navRows;
+    float sdfCellSize;
+    int32_t sdfCols;
+    int32_t sdfRows;
+    int32_t reserved;
+    MapFileSection collisionGrids; // MapFileCollisionGrid
+    MapFileSection navWalkable;    // uint8_t
+    MapFileSection sdfDistance;    // float
+    MapFileSection sdfGradient;    // Vector2
+};
+
+class MapFile {
+public:
+    const MapFileHeader* header;
+
+    MapFile();
+    bool Open(const char* path); // Maps the file and validates the header and sections
+    void Close();
+
+    template <typename T>
+    ArrayView<T> GetSection(const MapFileSection& section) const {
+        return ArrayView<T>((const T*)(file.data + section.offset), (size_t)section.count);
+    }
+
+    static bool Write(const Map& map, const char* path); // Bakes the map's current layout to disk
+
+private:
+    MappedFile file;
+
+    bool IsSectionValid(const MapFileSection& section, size_t elementSize) const;
+};
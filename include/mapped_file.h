@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+// Read-only memory mapping of a whole file (mmap on POSIX, MapViewOfFile on Windows).
+// The pages are loaded lazily by the OS, so opening a large file costs the same as a small one.
+class MappedFile {
+public:
+    const unsigned char* data;
+    size_t size;
+
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const char* path);
+    void Close();
+    bool IsOpen() const { return data != nullptr; }
+
+private:
+    void* fileHandle;    // Windows only
+    void* mappingHandle; // Windows only
+};
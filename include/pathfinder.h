@@ -0,0 +1,38 @@
+#pragma once
+
+#include "raylib.h"
+#include "array_view.h"
+#include <vector>
+#include <cstdint>
+
+class Map; // Forward declaration
+
+// Coarse navigation grid derived from the map obstacles, searched with A*.
+// A cell is walkable when a hider centred on it would be at a valid position.
+class Pathfinder {
+public:
+    int cellSize;
+    int cols;
+    int rows;
+    ArrayView<uint8_t> walkable; // Points into storage after Build, or into a mapped map file after Attach
+
+    Pathfinder();
+    void Build(const Map& gameMap);
+    void Attach(const Map& gameMap, int gridCellSize, int gridCols, int gridRows, ArrayView<uint8_t> bakedWalkable);
+
+    // Fills outPath with smoothed waypoints from start to goal (start excluded, goal included).
+    bool FindPath(Vector2 start, Vector2 goal, std::vector<Vector2>& outPath) const;
+
+    int CellIndex(Vector2 position) const;
+    Vector2 CellCenter(int cellIndex) const;
+    bool IsWalkable(int cx, int cy) const {
+        return cx >= 0 && cy >= 0 && cx < cols && cy < rows && walkable[cy * cols + cx];
+    }
+
+private:
+    const Map* map;
+    std::vector<uint8_t> storage;
+
+    int FindNearestWalkable(Vector2 position) const;
+    bool HasLineOfSight(Vector2 from, Vector2 to) const;
+};
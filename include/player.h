@@ -2,40 +2,62 @@
 
 #include "raylib.h"
 #include "constants.h"
+#include "seeker_input.h"
 #include <vector> // For vision cone points
 
-class GameManager; // Forward declaration
+class SpatialHash;
+class HiderBatch;
+class SpriteAtlas;
+class SpriteBatch;
 
-class Player {
-public:
+// Everything about the seeker that the simulation changes, kept apart from the textures and
+// the vision cone so a world snapshot can copy it as one block
+struct PlayerState {
     Vector2 position;
     float rotation; // in degrees, 0 is right, 90 is down
+    Vector2 previousPosition; // Before the last tick, drawing interpolates from here
+    float previousRotation;
     float speed;
     float sprintValue;
     bool isSprinting;
-    Texture2D texture;
-    Texture2D alertTexture;
-    Texture2D tagTexture; // New texture for tagging state
-    Sound tagSound; // New sound for tagging
     bool showAlert;
-    std::vector<Vector2> visionConePoints;
     bool isTagged;
-    GameManager* gameManager; // Reference to game manager
+    float tagRange; // TAG_RANGE unless a SimConfig says otherwise
+    float tagPoseTime; // Left of the tag pose, set by a tag in the applied input whoever controls the seeker
+
+    PlayerState() : position({0, 0}), rotation(0.0f), previousPosition({0, 0}), previousRotation(0.0f), speed(PLAYER_SPEED),
+                    sprintValue(SPRINT_MAX), isSprinting(false), showAlert(false), isTagged(false), tagRange(TAG_RANGE),
+                    tagPoseTime(0.0f) {}
+};
+
+class Player : public PlayerState {
+public:
+    // Atlas frames, -1 if the file was missing
+    int standFrame;
+    int tagFrame; // Just after a tag
+    int alertFrame;
+    float alertSize;
+    std::vector<Vector2> visionConePoints;
 
     Player();
+#ifndef HIDENSEEK_HEADLESS
+    void LoadAssets(SpriteAtlas& atlas); // Adds the sprites to the atlas, which has to be built before drawing
+    void Draw(float alpha, SpriteBatch& sprites); // alpha: fraction of a tick since the last Update
+#endif
     void Init(Vector2 startPos);
-    void HandleInput(const class Map& map);
-    void Update(float deltaTime, const class Map& map, const std::vector<class Hider>& hiders);
-    void Draw();
-    bool CanTag(const class Hider& hider) const;
+    void HandleInput(float deltaTime, const SeekerInput& input, const class Map& map);
+    void Update(float deltaTime, const SeekerInput& input, const class Map& map, const HiderBatch& hiders, const SpatialHash& hiderHash);
+    bool CanTag(Vector2 hiderPosition) const;
     Vector2 GetForwardVector() const;
+    Vector2 GetRenderPosition(float alpha) const;
     bool IsInVisionCone(Vector2 targetPos, float coneAngle, float visionRadius) const;
     bool IsLookingAt(Vector2 targetPos) const;
     void SetTagged(bool tagged) { isTagged = tagged; }
     bool IsInAlertStatus() const { return showAlert; }
+    bool IsTagging() const { return tagPoseTime > 0.0f; }
 
 private:
-    void UpdateVision();
+    void UpdateVision(Vector2 origin, float facing);
      // For drawing
 };
 
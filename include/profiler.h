@@ -0,0 +1,75 @@
+#pragma once
+
+// Scoped timing markers for seeing where a frame goes. They are only compiled in when
+// HIDENSEEK_PROFILE is defined (premake5 gmake2 --profile); otherwise PROFILE_SCOPE and
+// PROFILE_FRAME expand to nothing and the profiler isn't in the binary at all.
+//
+//     void Player::Update(...) {
+//         PROFILE_SCOPE("Player update");
+//
+// A scope records its start and end time into a ring owned by the calling thread when it
+// closes. Once per frame the main thread drains every ring (PROFILE_FRAME), adds the time up
+// per name and keeps the last PROFILER_HISTORY_FRAMES frames for the overlay's percentiles,
+// plus the last PROFILER_TRACE_EVENTS events for a Chrome trace. Names are kept by pointer,
+// so pass string literals.
+
+#ifdef HIDENSEEK_PROFILE
+
+#include <atomic>  // For the ring's write index
+#include <cstdint>
+
+const int PROFILER_RING_EVENTS = 4096; // Per thread, power of two; more than this in one frame and the oldest are lost
+const int PROFILER_MAX_THREADS = 64;
+const int PROFILER_HISTORY_FRAMES = 300;
+const int PROFILER_TRACE_EVENTS = 65536;
+
+struct ProfileEvent {
+    const char* name;
+    uint64_t start; // Nanoseconds since the profiler started
+    uint64_t end;
+};
+
+// Events from one thread. Only that thread writes and only the main thread reads, so neither
+// side locks: the writer publishes each event by bumping writeIndex, and the reader drops
+// whatever the writer may have lapped while it was copying.
+struct ProfileRing {
+    ProfileEvent events[PROFILER_RING_EVENTS];
+    std::atomic<uint64_t> writeIndex;
+    uint64_t readIndex; // Reader only
+    int threadId;
+
+    ProfileRing() : writeIndex(0), readIndex(0), threadId(0) {}
+};
+
+class Profiler {
+public:
+    static uint64_t Now();
+    static void Record(const char* name, uint64_t start, uint64_t end);
+    static void EndFrame(); // Main thread only, after the frame is drawn
+    static bool WriteTrace(const char* path); // trace_event JSON, for chrome://tracing or ui.perfetto.dev
+#ifndef HIDENSEEK_HEADLESS
+    static void DrawOverlay(int x, int y); // Milliseconds per name: last frame, p50 and p99
+#endif
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name(name), start(Profiler::Now()) {}
+    ~ProfileScope() { Profiler::Record(name, start, Profiler::Now()); }
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FRAME() Profiler::EndFrame()
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_FRAME()
+
+#endif
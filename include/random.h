@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+// Stream ids, so every consumer of a match seed draws independent numbers
+const uint64_t RANDOM_STREAM_NEXT_MATCH = 0; // Seed of the next match when restarting
+const uint64_t RANDOM_STREAM_SPAWN = 1;      // Player and hider starting positions
+const uint64_t RANDOM_STREAM_HIDER_BASE = 2; // Hider i uses RANDOM_STREAM_HIDER_BASE + i
+
+// Counter-based generator: the n-th number of a stream is a hash of (seed, stream, n), so it
+// holds no state besides the counter and streams never depend on each other's draw order.
+// The hash is the SplitMix64 finalizer applied to a Weyl sequence.
+struct RandomStream {
+    uint64_t key;
+    uint64_t counter;
+
+    RandomStream() : key(0), counter(0) {}
+    RandomStream(uint64_t seed, uint64_t stream) : key(Mix(seed ^ Mix(stream + 0x9E3779B97F4A7C15ull))), counter(0) {}
+
+    static uint64_t Mix(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t NextU64() { return Mix(key + (++counter) * 0x9E3779B97F4A7C15ull); }
+    uint32_t NextU32() { return (uint32_t)(NextU64() >> 32); }
+
+    // 0 .. range-1; range must be positive
+    int NextInt(int range) { return (int)(((uint64_t)NextU32() * (uint64_t)range) >> 32); }
+
+    // [0, 1)
+    float NextFloat() { return (float)(NextU32() >> 8) * (1.0f / 16777216.0f); }
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "seeker_controller.h"
+#include "sim_config.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef> // For size_t
+
+// .hsreplay file: this header followed by inputBytes bytes of encoded input. On a given map and
+// tick rate, a match is fully determined by its seed, its SimConfig and the seeker's input on
+// every tick, so that is all a replay stores, with the map's hash and the tick rate to refuse
+// playback on anything else. The result is kept to tell when playback no longer matches the recording.
+const uint32_t REPLAY_FILE_MAGIC = 0x4C505248; // "HRPL"
+const uint32_t REPLAY_FILE_VERSION = 2;
+const int REPLAY_MAX_HIDERS = 1024; // More than any match is played with; past this the header is corrupt
+
+struct ReplayFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t seed;
+    uint64_t mapHash; // Map::layoutHash of the map it was played on
+    float tickRate;   // SIM_TICK_RATE of the build that recorded it
+    int32_t hiderCount;
+    float hidingPhaseDuration;
+    float seekingPhaseDuration;
+    float tagRange;
+    float hiderAttackCooldown;
+    int32_t result;    // MatchResult at the end of the recording
+    uint32_t tickCount;
+    uint32_t inputBytes;
+};
+
+// Seeker input of one match, one entry per run of ticks with the same buttons. SeekerInput
+// flags fit in 7 bits, so an entry is the flags byte alone for a single tick, or the flags
+// byte with the top bit set followed by the run length minus one as a LEB128 varint.
+// Buttons change a few times a second at most, which keeps a minute of play to a few hundred bytes.
+class Replay {
+public:
+    uint64_t seed;
+    uint64_t mapHash;
+    SimConfig config;
+    int result;    // MatchResult, set by whoever finishes the recording
+    int tickCount;
+    std::vector<uint8_t> inputs;
+
+    Replay();
+    void Begin(uint64_t matchSeed, const SimConfig& matchConfig, uint64_t matchMapHash);
+    void Record(SeekerInput input); // Once per tick, in tick order
+    void Finish(int matchResult);   // Writes out the run still being counted
+    void TruncateTo(int ticks);     // Drops everything after the first ticks, after rewinding the match
+    bool Save(const char* path) const;
+    bool Load(const char* path); // False also if it was recorded at another tick rate or the header is out of range
+    bool IsForMap(uint64_t layoutHash) const { return mapHash == layoutHash; } // Check before playing
+
+private:
+    uint8_t runFlags;
+    uint32_t runLength;
+
+    void FlushRun();
+};
+
+// Plays a Replay back as the seeker. Together with the recorded seed and config the simulation
+// repeats the match tick for tick, whatever the frame rate or thread count.
+class ReplaySeekerController : public SeekerController {
+public:
+    ReplaySeekerController();
+    void Start(const Replay* replayToPlay); // Replay must outlive playback
+    void Reset() override; // Back to the first tick
+    void SeekTo(int tick); // Next input is the one recorded for this tick
+    SeekerInput NextInput(const Simulation& sim) override;
+    bool IsFinished() const;
+
+private:
+    const Replay* replay;
+    size_t readOffset;
+    uint8_t runFlags;
+    uint32_t runRemaining; // Ticks left in the current run
+    int ticksPlayed;
+};
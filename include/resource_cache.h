@@ -0,0 +1,59 @@
+#pragma once
+
+#include "raylib.h"
+#include "asset_archive.h"
+#include <string>
+#include <unordered_map>
+
+// Textures, sounds and fonts shared by file path, so every file is decoded once no matter how
+// many places use it. Acquire loads a file the first time it is asked for and hands out the
+// same asset after that, counting references; Release drops one, and the asset is unloaded
+// with the last. A missing file gives an empty asset (id 0, frameCount 0), which raylib's draw
+// and play calls already skip.
+//
+// Insert hands the cache an asset loaded elsewhere (AssetLoader decodes on worker threads),
+// holding one reference for the caller, so later Acquires of that path don't load it again.
+//
+// Files are read from the packed archive when it has them, from the resources directory otherwise.
+//
+// A shared Sound also shares its volume and pitch, so whoever plays it should set them.
+class ResourceCache {
+public:
+    AssetArchive archive; // Open it before acquiring anything; music streams opened from it borrow its memory
+
+    ~ResourceCache(); // Unloads whatever is still held, with a warning, since each is a missing Release
+
+    Texture2D AcquireTexture(const char* path);
+    bool ReleaseTexture(Texture2D texture); // False if the texture didn't come from the cache
+    Sound AcquireSound(const char* path);
+    bool ReleaseSound(Sound sound);
+    Font AcquireFont(const char* path); // An SDF font, drawn with SdfFont::Draw
+    bool ReleaseFont(Font font);
+
+    // Return what the cache now holds, which is the earlier copy if the path was already loaded
+    Texture2D InsertTexture(const char* path, Texture2D texture);
+    Sound InsertSound(const char* path, Sound sound);
+    Font InsertFont(const char* path, Font font);
+
+    int GetDecodeCount() const { return decodeCount; } // Files loaded since startup
+    size_t GetResidentBytes() const; // Pixel and sample data currently loaded, in GPU and audio memory
+
+private:
+    struct TextureEntry {
+        Texture2D texture;
+        int references;
+    };
+    struct SoundEntry {
+        Sound sound;
+        int references;
+    };
+    struct FontEntry {
+        Font font;
+        int references;
+    };
+
+    std::unordered_map<std::string, TextureEntry> textures;
+    std::unordered_map<std::string, SoundEntry> sounds;
+    std::unordered_map<std::string, FontEntry> fonts;
+    int decodeCount = 0;
+};
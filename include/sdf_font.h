@@ -0,0 +1,53 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstdint>
+
+// Fonts rasterized once as signed distance fields, so one atlas draws crisply from HUD text up
+// to the 120px title and through the pulsing scales in between. Drawing needs the SDF shader,
+// so text in these fonts goes through SdfFont::Draw.
+//
+// Rasterizing is the slow part, so each bake is cached in FONT_CACHE_DIRECTORY as
+// <hash of the font file>.hsfont: the glyph metrics and the atlas pixels as they are uploaded.
+// Later runs read that back and upload the atlas in one go; editing the font changes the hash.
+const uint32_t SDF_FONT_MAGIC = 0x544E4648; // "HFNT"
+const uint32_t SDF_FONT_VERSION = 1;
+const int SDF_FONT_BASE_SIZE = 64; // Rasterized size; the field keeps edges sharp well past it
+const int SDF_FONT_GLYPH_COUNT = 95; // Printable ASCII from ' ', which covers every string the game draws
+
+struct SdfFontFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t fontHash; // FNV-1a of the font file
+    int32_t baseSize;
+    int32_t glyphCount;
+    int32_t atlasWidth;
+    int32_t atlasHeight; // Atlas pixels follow the glyphs, GRAY_ALPHA
+};
+
+struct SdfFontFileGlyph {
+    int32_t value;
+    int32_t offsetX;
+    int32_t offsetY;
+    int32_t advanceX;
+    Rectangle rec; // In the atlas
+};
+
+class SdfFont {
+public:
+    // CPU half, safe on worker threads: reads the cached bake or rasterizes and caches it. On
+    // success font has its glyphs but no texture yet, and atlas holds the pixels for Upload.
+    static bool Bake(const unsigned char* fileData, int dataSize, Font& font, Image& atlas);
+    static Font Upload(Font font, Image atlas); // Main thread; takes the atlas
+    static Font Load(const unsigned char* fileData, int dataSize); // Both halves, Font{0} on failure
+
+    // DrawTextEx with the SDF shader; raylib's default font isn't a field and is drawn as it is
+    static void Draw(Font font, const char* text, Vector2 position, float fontSize, float spacing, Color tint);
+    // For drawing glyphs some other way: binds the shader unless font is the default; true if it did
+    static bool BeginDraw(Font font);
+    static void EndDraw();
+    static void UnloadShader(); // At shutdown, while the GL context is still up
+
+private:
+    static Shader shader;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "raylib.h"
+#include "seeker_controller.h"
+#include <vector>
+#include <cstdint>
+
+enum class SeekerPolicy {
+    IDLE,  // Never moves, so hiders can only lose by running out of time
+    SWEEP, // Visits the hiding spots nearest first and chases hiders it sees, like a player would
+    CHASE  // Knows where every hider is and paths to the nearest one
+};
+
+// Scripted seeker. It only produces SeekerInput, the same buttons a player presses, so the
+// simulation treats it exactly like the keyboard. Its state is a path and a few counters,
+// so thousands of them can run side by side in batch jobs.
+class SeekerBot : public SeekerController {
+public:
+    SeekerPolicy policy;
+
+    SeekerBot(SeekerPolicy botPolicy = SeekerPolicy::SWEEP);
+    void Reset() override;
+    SeekerInput NextInput(const Simulation& sim) override;
+
+private:
+    int targetHider;   // Hider being chased, -1 while sweeping
+    int targetSpot;    // Hiding spot being walked to, -1 when none is picked
+    Vector2 goal;      // Where the current path leads
+    int lastPlanTick;
+    std::vector<Vector2> path;
+    int pathIndex;
+    std::vector<uint8_t> visitedSpots; // Sweep progress, cleared once every spot has been checked
+
+    int FindNearestHider(const Simulation& sim, bool visibleOnly) const;
+    int FindNearestUnvisitedSpot(const Simulation& sim);
+    void PlanTo(const Simulation& sim, Vector2 target);
+    uint8_t SteerAlongPath(const Simulation& sim);
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "seeker_input.h"
+
+class Simulation;
+
+// Whatever plays the seeker: the keyboard in the game, a SeekerBot in headless runs (or in the
+// game, for watching it play). The simulation only ever sees the SeekerInput it produces.
+class SeekerController {
+public:
+    virtual ~SeekerController() {}
+    virtual void Reset() {} // New match, drop anything remembered from the last one
+    virtual SeekerInput NextInput(const Simulation& sim) = 0; // Called once per simulation tick
+};
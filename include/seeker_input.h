@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// Buttons the seeker holds during one simulation tick
+enum SeekerInputFlags : uint8_t {
+    SEEKER_INPUT_UP = 1 << 0,
+    SEEKER_INPUT_DOWN = 1 << 1,
+    SEEKER_INPUT_LEFT = 1 << 2,
+    SEEKER_INPUT_RIGHT = 1 << 3,
+    SEEKER_INPUT_SPRINT = 1 << 4,
+    SEEKER_INPUT_TAG = 1 << 5,         // Tag press this tick
+    SEEKER_INPUT_SKIP_HIDING = 1 << 6, // Skip the rest of the hiding phase
+};
+
+// Everything the simulation needs from whoever controls the seeker, so it never reads the keyboard itself
+struct SeekerInput {
+    uint8_t flags;
+
+    SeekerInput() : flags(0) {}
+    explicit SeekerInput(uint8_t inputFlags) : flags(inputFlags) {}
+    bool Has(SeekerInputFlags flag) const { return (flags & flag) != 0; }
+};
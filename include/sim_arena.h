@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstring> // For memset
+
+// Writable counterpart of ArrayView: an array that lives in a SimArena. Never owns the data.
+template <typename T>
+struct ArraySpan {
+    T* data = nullptr;
+    size_t count = 0;
+
+    T& operator[](size_t index) const { return data[index]; }
+    T* begin() const { return data; }
+    T* end() const { return data + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void Fill(const T& value) const {
+        for (size_t i = 0; i < count; ++i) data[i] = value;
+    }
+};
+
+// One zeroed block of bytes that a set of arrays is carved out of, so all of them can be
+// copied, snapshotted or restored with a single memcpy. Only trivially copyable types
+// belong in here.
+//
+// The block can't grow once handed out, so a layout is run twice: once between BeginLayout
+// and CommitLayout to measure it, then again to hand out the real spans.
+class SimArena {
+public:
+    SimArena() : used(0), measuring(false) {}
+
+    void BeginLayout() {
+        used = 0;
+        measuring = true;
+    }
+
+    void CommitLayout() {
+        bytes.assign(used, 0);
+        used = 0;
+        measuring = false;
+    }
+
+    template <typename T>
+    void Allocate(ArraySpan<T>& span, size_t count) {
+        size_t offset = (used + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        used = offset + count * sizeof(T);
+        span.data = measuring ? nullptr : (T*)(bytes.data() + offset);
+        span.count = count;
+    }
+
+    unsigned char* Data() { return bytes.data(); }
+    const unsigned char* Data() const { return bytes.data(); }
+    size_t Size() const { return bytes.size(); }
+
+private:
+    static const size_t ALIGNMENT = 16;
+
+    std::vector<unsigned char> bytes;
+    size_t used;
+    bool measuring;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "constants.h"
+#include <cmath> // For fmodf
+
+// Fixed-timestep accumulator: frame time goes in, a whole number of simulation ticks comes out,
+// and the leftover fraction of a tick is used to interpolate drawing between the last two ticks.
+struct SimClock {
+    float tickDelta; // Seconds per tick
+    float accumulator;
+
+    SimClock() : tickDelta(1.0f / SIM_TICK_RATE), accumulator(0.0f) {}
+
+    void Reset() { accumulator = 0.0f; }
+
+    // Number of ticks to run this frame. A long frame is capped, so a hitch slows the game down
+    // for a moment rather than making every following frame run even more ticks.
+    // speed scales simulated time per real second, for fast-forwarding replays.
+    int Advance(float frameTime, float speed = 1.0f) {
+        float maxFrameTime = tickDelta * SIM_MAX_TICKS_PER_FRAME * speed;
+        frameTime *= speed;
+        accumulator += frameTime < maxFrameTime ? frameTime : maxFrameTime;
+        int ticks = (int)(accumulator / tickDelta);
+        accumulator -= ticks * tickDelta;
+        return ticks;
+    }
+
+    // How far the render frame is past the last tick, 0..1
+    float GetAlpha() const { return accumulator / tickDelta; }
+};
+
+// Interpolates between two angles in degrees the short way round
+inline float LerpAngle(float from, float to, float t) {
+    float difference = fmodf(to - from, 360.0f);
+    if (difference > 180.0f) difference -= 360.0f;
+    else if (difference < -180.0f) difference += 360.0f;
+    return from + difference * t;
+}
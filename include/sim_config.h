@@ -0,0 +1,16 @@
+#pragma once
+
+#include "constants.h"
+
+// Gameplay tunables that batch runs sweep over. Defaults are the values the game ships with.
+struct SimConfig {
+    int hiderCount;
+    float hidingPhaseDuration;  // seconds
+    float seekingPhaseDuration; // seconds
+    float tagRange;             // How close the seeker needs to be to tag
+    float hiderAttackCooldown;  // Seconds after a hider lands a tag before it can attack again
+
+    SimConfig() : hiderCount(NUM_HIDERS), hidingPhaseDuration(HIDING_PHASE_DURATION),
+                  seekingPhaseDuration(SEEKING_PHASE_DURATION), tagRange(TAG_RANGE),
+                  hiderAttackCooldown(HIDER_ATTACK_COOLDOWN) {}
+};
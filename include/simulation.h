@@ -0,0 +1,88 @@
+#pragma once
+
+#include "game_state.h"
+#include "player.h"
+#include "hider_batch.h"
+#include "map.h"
+#include "flee_field.h"
+#include "spatial_hash.h"
+#include "seeker_input.h"
+#include "sim_config.h"
+#include <cstdint>
+#include <cstddef> // For size_t
+
+enum class MatchResult {
+    NONE,          // Still running
+    SEEKER_WON,    // Every hider tagged
+    SEEKER_TAGGED, // A hider reached the seeker
+    TIME_UP        // Seeking phase ran out
+};
+
+// The match-wide scalars of a Simulation, kept apart so a world snapshot can copy them as one block
+struct SimulationState {
+    GamePhase currentPhase;
+    SimConfig config; // Read by Reset, so changes take effect from the next match
+    uint64_t matchSeed; // Every random decision in a match comes from this
+    float gameTimer; // Used for both hiding and seeking phases
+    float hidingPhaseElapsed;
+    int hidersRemaining;
+    int tickCount; // Ticks since Reset
+    MatchResult result;
+    float lastGameTime; // Seeking time used when the match ended
+
+    // Match statistics for batch runs
+    float hidingDwell[3];  // Hider-seconds spent in each HiderHidingFSMState, untagged hiders only
+    float seekingDwell[3]; // Same for each HiderSeekingFSMState
+
+    // What happened during the last Tick, for sounds and screen changes
+    bool seekingPhaseStarted;
+    int tagEvents; // Hiders tagged by the seeker plus times the seeker got tagged
+
+    SimulationState() : currentPhase(GamePhase::HIDING), matchSeed(0), gameTimer(0.0f), hidingPhaseElapsed(0.0f),
+                        hidersRemaining(0), tickCount(0), result(MatchResult::NONE), lastGameTime(0.0f),
+                        hidingDwell{0}, seekingDwell{0}, seekingPhaseStarted(false), tagEvents(0) {}
+};
+
+// Header of a world snapshot; the hider arena follows it directly
+struct SimulationSnapshotHeader {
+    SimulationState sim;
+    PlayerState player;
+    HiderBatchState hiders;
+    uint64_t arenaBytes;
+};
+
+// One match of hide and seek with no window, textures or audio: the map, the seeker, the
+// hiders and the win/loss rules. GameManager drives it one tick at a time and draws it;
+// the headless build steps it as fast as it can.
+//
+// Everything a tick changes is in SimulationState, PlayerState, HiderBatchState and the hider
+// arena, all trivially copyable, so the whole world can be snapshotted into a flat buffer and
+// restored without touching textures or reloading anything. The flee field and the spatial
+// hash are rebuilt from it on restore.
+class Simulation : public SimulationState {
+public:
+    Player player;
+    HiderBatch hiders;
+    Map gameMap;
+    FleeField fleeField; // Shared by evading hiders, updated once per tick in the seeking phase
+    SpatialHash hiderHash; // Hider positions (and hiding spot claims while hiding), rebuilt once per tick
+
+    Simulation();
+    void LoadMap();
+    void Reset(uint64_t seed); // New match on the loaded map
+    void Tick(float deltaTime, const SeekerInput& input);
+    bool IsOver() const { return result != MatchResult::NONE; }
+    bool PlayerWon() const { return result == MatchResult::SEEKER_WON; }
+
+    // World snapshots, for rewind, save states and forked rollouts on the same map
+    size_t GetSnapshotSize() const { return sizeof(SimulationSnapshotHeader) + hiders.arena.Size(); }
+    void SaveSnapshot(unsigned char* out) const; // out must hold GetSnapshotSize() bytes
+    void LoadSnapshot(const unsigned char* in);
+
+private:
+    void StartHidingPhase();
+    void StartSeekingPhase();
+    void RebuildHiderHash();
+    void AccumulateDwell(float deltaTime);
+    void CheckWinLossConditions(bool playerGotTagged);
+};
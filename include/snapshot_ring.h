@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+class Simulation;
+
+// The last few hundred world snapshots in one preallocated block, oldest overwritten first.
+// Pushing once per tick gives a rewind buffer; every slot is the same size, so pushing
+// is a single copy into memory that is already there.
+class SnapshotRing {
+public:
+    SnapshotRing();
+    void Clear();
+    void Push(const Simulation& sim); // Starts over if the snapshot size changed (a different hider count)
+    bool Pop(Simulation& sim);        // Restores the newest snapshot and drops it; false when empty
+    int Count() const { return count; }
+
+private:
+    std::vector<unsigned char> storage;
+    size_t slotSize;
+    int capacity;
+    int head;  // Slot the next Push writes
+    int count;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "raylib.h"
+#include <vector>
+
+// Uniform grid of points bucketed by cell, for radius queries over hiders and hiding spot claims.
+// Each cell keeps a singly linked list of entries, so Insert is O(1) at any time during a tick
+// and Clear only resets the cell heads.
+class SpatialHash {
+public:
+    struct Entry {
+        Vector2 position;
+        int id;   // Caller-defined, e.g. the hider index
+        int next; // Next entry in the same cell, -1 at the end
+    };
+
+    float cellSize;
+    int cols;
+    int rows;
+    std::vector<int> cellHead; // First entry per cell, -1 if empty
+    std::vector<Entry> entries;
+
+    SpatialHash();
+    void Init(float hashCellSize, int worldWidth, int worldHeight);
+    void Clear();
+    void Insert(int id, Vector2 position);
+
+    // Calls visit(id, position) for every entry within radius of center; stops early when visit returns true.
+    // Returns true if a visit stopped the query.
+    template <typename Visitor>
+    bool Query(Vector2 center, float radius, Visitor visit) const {
+        if (cellHead.empty()) return false;
+        int x0 = CellCoord(center.x - radius, cols);
+        int x1 = CellCoord(center.x + radius, cols);
+        int y0 = CellCoord(center.y - radius, rows);
+        int y1 = CellCoord(center.y + radius, rows);
+        float radiusSqr = radius * radius;
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                for (int i = cellHead[y * cols + x]; i >= 0; i = entries[i].next) {
+                    const Entry& entry = entries[i];
+                    float dx = entry.position.x - center.x;
+                    float dy = entry.position.y - center.y;
+                    if (dx * dx + dy * dy <= radiusSqr && visit(entry.id, entry.position)) return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // True if any entry other than excludeId lies within radius of center
+    bool AnyInRadius(Vector2 center, float radius, int excludeId = -1) const {
+        return Query(center, radius, [excludeId](int id, Vector2) { return id != excludeId; });
+    }
+
+private:
+    // Positions outside the world are clamped into the border cells
+    int CellCoord(float value, int count) const {
+        int cell = (int)(value / cellSize);
+        if (value < 0 || cell < 0) return 0;
+        return cell >= count ? count - 1 : cell;
+    }
+};
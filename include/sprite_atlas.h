@@ -0,0 +1,48 @@
+#pragma once
+
+#include "raylib.h"
+#include "asset_archive.h"
+#include <vector>
+
+// The character sprites packed into one texture at load time, so the seeker and every hider
+// can be drawn without switching textures in between. Add images, Build once, then draw
+// frames by the index Add returned.
+class SpriteAtlas {
+public:
+    Texture2D texture;
+
+    explicit SpriteAtlas(const AssetArchive* archive = nullptr); // AddFile reads from archive when given one
+    int AddFile(const char* path); // Frame index, or -1 if the file is missing
+    int AddImage(Image image); // Takes the image; it is unloaded once packed
+    void Build(); // Packs everything added and uploads it
+    void Unload();
+    Rectangle GetFrame(int frame) const { return frames[frame]; } // Where the frame sits in texture
+
+private:
+    std::vector<Image> pending; // Added, waiting for Build
+    std::vector<Rectangle> frames;
+    const AssetArchive* archive;
+};
+
+// One sprite of a SpriteBatch, drawn centred on position as a size x size square
+struct SpriteInstance {
+    int frame;
+    Vector2 position;
+    float rotation; // in degrees
+    float size;
+};
+
+// Sprites gathered over a pass and drawn together from one atlas. With a single texture
+// bound, raylib's render batch takes them all in one draw call, however many there are, as
+// long as nothing else is drawn in between; so gather first and draw lines or shapes after End.
+class SpriteBatch {
+public:
+    SpriteBatch();
+    void Begin(const SpriteAtlas& spriteAtlas);
+    void Add(int frame, Vector2 position, float rotation, float size);
+    void End(); // Draws everything added since Begin
+
+private:
+    const SpriteAtlas* atlas;
+    std::vector<SpriteInstance> instances;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+const int TEXT_CACHE_MAX_RUNS = 256; // Past this, runs not drawn for TEXT_CACHE_IDLE_SECONDS are dropped
+const double TEXT_CACHE_IDLE_SECONDS = 1.0;
+const float TEXT_LINE_GAP = 0.1f; // Between the lines of a multi-line run, as a fraction of the font size
+
+enum class TextAlign {
+    LEFT,
+    CENTER // Each line centred on the widest
+};
+
+// One glyph of a laid-out run, relative to the run's top-left corner at its font size
+struct TextQuad {
+    Rectangle dest;
+    Rectangle uv; // Normalized texture coordinates in the font atlas
+    bool outline; // Part of the outline pass, drawn in the outline colour under the text
+};
+
+struct TextRun {
+    std::string text;
+    Font font;
+    float fontSize;
+    float spacing;
+    float outline; // Offset of the outline copies in pixels, 0 for none
+    TextAlign align;
+    Vector2 size; // What MeasureTextEx would return
+    std::vector<TextQuad> quads;
+    double lastUsed;
+};
+
+// Text shaped and measured once, then drawn from the stored quads. Get looks a run up by
+// string, font, size, spacing and outline, laying it out only the first time; text that
+// doesn't change from frame to frame costs a hash and a compare. Draw emits the run's quads
+// as one batch, outline included, through the SDF shader, and can scale it for pulsing text.
+class TextCache {
+public:
+    const TextRun& Get(Font font, const char* text, float fontSize, float spacing = 1, float outline = 0,
+                       TextAlign align = TextAlign::LEFT);
+    void Clear(); // When fonts are reloaded, since runs point into their glyphs
+
+    static void Draw(const TextRun& run, Vector2 position, Color tint, float scale = 1.0f, Color outlineColor = BLANK);
+
+private:
+    std::unordered_map<uint64_t, TextRun> runs;
+
+    static void Layout(TextRun& run);
+    void Trim(); // Drops runs that haven't been drawn lately, once there are too many
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+// Fixed set of worker threads for data-parallel loops. ParallelFor hands out chunks of
+// an index range to the workers and the calling thread, and returns once all are done.
+class ThreadPool {
+public:
+    explicit ThreadPool(int workerCount = -1); // -1: one worker per hardware thread besides the caller
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int GetWorkerCount() const { return (int)workers.size(); }
+
+    // Runs body(begin, end) over [0, count) in chunks of at least minChunk indices.
+    // Small ranges run inline on the calling thread.
+    void ParallelFor(int count, int minChunk, const std::function<void(int begin, int end)>& body);
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeWorkers;
+    std::condition_variable jobDone;
+
+    // Current job, valid while pendingWorkers > 0
+    const std::function<void(int, int)>* job;
+    int jobCount;
+    int chunkSize;
+    std::atomic<int> nextChunk;
+    int pendingWorkers;
+    uint64_t generation; // Bumped for every job, so workers can tell a new job from a spurious wakeup
+    bool stopping;
+
+    void WorkerLoop();
+    void RunChunks();
+};
@@ -4,6 +4,10 @@
 #include "raylib.h"
 #include "game_state.h" // For GameScreen
 #include "constants.h"  // For font/color constants
+#include "text_cache.h"
+
+class ResourceCache;
+class AssetLoader;
 
 class UIManager {
 public:
@@ -20,11 +24,19 @@ public:
     // Font hudTextFont;  // If you have it
 
     int currentInstructionPage; // To track which instruction page is visible (1 or 2)
+    TextCache text; // Laid-out labels and HUD text, so unchanged text isn't measured every frame
 
     UIManager();
-    void LoadAssets();
-    void UnloadAssets();
+    // Fonts, the click sound and the menu music are used on every screen and stay loaded; the
+    // backgrounds belong to their screen and can be unloaded while it isn't showing
+    void RequestSharedAssets(AssetLoader& loader, int group);
+    void RequestScreenAssets(GameScreen screen, AssetLoader& loader, int group);
+    void LoadSharedAssets(ResourceCache& resources);
+    void LoadScreenAssets(GameScreen screen, ResourceCache& resources);
+    void UnloadScreenAssets(GameScreen screen, ResourceCache& resources);
+    void UnloadAssets(ResourceCache& resources); // Everything, at shutdown
 
+    void DrawLoadingScreen(float progress);
     void DrawMainMenu(GameScreen& currentScreen, bool& quitGameFlag, bool& wantsToStartNewGame);
     void DrawHowToPlay(GameScreen& currentScreen); // Signature remains the same
     void DrawInGameHUD(float timer, int hidersLeft, float sprintValue);
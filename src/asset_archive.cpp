@@ -0,0 +1,163 @@
+#include "asset_archive.h"
+#include "sdf_font.h"
+#include <algorithm> // For std::sort, std::lower_bound
+#include <cstdio>    // For fopen, fwrite
+#include <cstring>   // For memcpy, memchr, strncmp
+
+AssetArchive::AssetArchive() : entries(nullptr), entryCount(0) {
+}
+
+bool AssetArchive::Open(const char* path) {
+    Close();
+    if (!file.Open(path)) return false;
+
+    if (file.size < sizeof(AssetArchiveHeader)) {
+        Close();
+        return false;
+    }
+
+    const AssetArchiveHeader* header = (const AssetArchiveHeader*)file.data;
+    if (header->magic != ASSET_ARCHIVE_MAGIC || header->version != ASSET_ARCHIVE_VERSION ||
+        header->entriesOffset % ASSET_ARCHIVE_ALIGNMENT != 0 || header->entriesOffset > file.size ||
+        header->entryCount > (file.size - header->entriesOffset) / sizeof(AssetArchiveEntry)) {
+        Close();
+        return false;
+    }
+
+    // Find relies on terminated, sorted names, and the loaders on data inside the file
+    const AssetArchiveEntry* fileEntries = (const AssetArchiveEntry*)(file.data + header->entriesOffset);
+    for (uint64_t i = 0; i < header->entryCount; ++i) {
+        const AssetArchiveEntry& entry = fileEntries[i];
+        bool valid = memchr(entry.name, '\0', ASSET_ARCHIVE_NAME_LENGTH) != nullptr &&
+                     (i == 0 || strncmp(fileEntries[i - 1].name, entry.name, ASSET_ARCHIVE_NAME_LENGTH) < 0) &&
+                     entry.encoding <= (uint32_t)AssetEncoding::RGBA8 &&
+                     entry.offset % ASSET_ARCHIVE_ALIGNMENT == 0 && entry.offset <= file.size &&
+                     entry.size <= file.size - entry.offset;
+        if (valid && entry.encoding == (uint32_t)AssetEncoding::RGBA8) {
+            valid = entry.width > 0 && entry.height > 0 && entry.size == (uint64_t)entry.width * entry.height * 4;
+        }
+        if (!valid) {
+            Close();
+            return false;
+        }
+    }
+
+    entries = fileEntries;
+    entryCount = (size_t)header->entryCount;
+    return true;
+}
+
+void AssetArchive::Close() {
+    entries = nullptr;
+    entryCount = 0;
+    file.Close();
+}
+
+const AssetArchiveEntry* AssetArchive::Find(const char* name) const {
+    if (!entries) return nullptr;
+    const AssetArchiveEntry* end = entries + entryCount;
+    const AssetArchiveEntry* found = std::lower_bound(entries, end, name, [](const AssetArchiveEntry& entry, const char* key) {
+        return strncmp(entry.name, key, ASSET_ARCHIVE_NAME_LENGTH) < 0;
+    });
+    if (found == end || strncmp(found->name, name, ASSET_ARCHIVE_NAME_LENGTH) != 0) return nullptr;
+    return found;
+}
+
+bool AssetArchive::Exists(const char* path) const {
+    return Find(path) != nullptr || FileExists(path);
+}
+
+Image AssetArchive::ReadImage(const char* path) const {
+    const AssetArchiveEntry* entry = Find(path);
+    if (!entry) return FileExists(path) ? LoadImage(path) : Image{0};
+
+    switch ((AssetEncoding)entry->encoding) {
+    case AssetEncoding::QOI:
+        return LoadImageFromMemory(".qoi", GetData(*entry), (int)entry->size);
+    case AssetEncoding::RGBA8: {
+        // Copied out, since the caller owns the pixels and frees them with UnloadImage
+        Image image = {0};
+        image.data = MemAlloc((unsigned int)entry->size);
+        memcpy(image.data, GetData(*entry), (size_t)entry->size);
+        image.width = entry->width;
+        image.height = entry->height;
+        image.mipmaps = 1;
+        image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        return image;
+    }
+    default:
+        return LoadImageFromMemory(GetFileExtension(path), GetData(*entry), (int)entry->size);
+    }
+}
+
+Wave AssetArchive::ReadWave(const char* path) const {
+    const AssetArchiveEntry* entry = Find(path);
+    if (!entry) return FileExists(path) ? LoadWave(path) : Wave{0};
+    return LoadWaveFromMemory(GetFileExtension(path), GetData(*entry), (int)entry->size);
+}
+
+bool AssetArchive::BakeFont(const char* path, Font& font, Image& atlas) const {
+    const AssetArchiveEntry* entry = Find(path);
+    if (entry) return SdfFont::Bake(GetData(*entry), (int)entry->size, font, atlas);
+
+    if (!FileExists(path)) return false;
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(path, &dataSize);
+    if (data == NULL) return false;
+    bool baked = SdfFont::Bake(data, dataSize, font, atlas);
+    UnloadFileData(data);
+    return baked;
+}
+
+Font AssetArchive::ReadFont(const char* path) const {
+    Font font = {0};
+    Image atlas = {0};
+    if (!BakeFont(path, font, atlas)) return Font{0};
+    return SdfFont::Upload(font, atlas);
+}
+
+Music AssetArchive::OpenMusic(const char* path) const {
+    const AssetArchiveEntry* entry = Find(path);
+    if (!entry) return FileExists(path) ? LoadMusicStream(path) : Music{0};
+    return LoadMusicStreamFromMemory(GetFileExtension(path), GetData(*entry), (int)entry->size);
+}
+
+bool AssetArchive::Write(std::vector<AssetArchiveInput>& inputs, const char* path) {
+    std::sort(inputs.begin(), inputs.end(), [](const AssetArchiveInput& a, const AssetArchiveInput& b) {
+        return a.name < b.name;
+    });
+
+    size_t entriesOffset = (sizeof(AssetArchiveHeader) + ASSET_ARCHIVE_ALIGNMENT - 1) / ASSET_ARCHIVE_ALIGNMENT * ASSET_ARCHIVE_ALIGNMENT;
+    std::vector<unsigned char> buffer(entriesOffset + inputs.size() * sizeof(AssetArchiveEntry), 0);
+    std::vector<AssetArchiveEntry> fileEntries;
+    for (const AssetArchiveInput& input : inputs) {
+        if (input.name.size() >= (size_t)ASSET_ARCHIVE_NAME_LENGTH) return false;
+        if (!fileEntries.empty() && input.name == fileEntries.back().name) return false;
+
+        AssetArchiveEntry entry = {};
+        memcpy(entry.name, input.name.c_str(), input.name.size());
+        entry.encoding = (uint32_t)input.encoding;
+        entry.width = input.width;
+        entry.height = input.height;
+        entry.offset = (buffer.size() + ASSET_ARCHIVE_ALIGNMENT - 1) / ASSET_ARCHIVE_ALIGNMENT * ASSET_ARCHIVE_ALIGNMENT;
+        entry.size = input.data.size();
+        buffer.resize((size_t)(entry.offset + entry.size), 0);
+        if (!input.data.empty()) memcpy(&buffer[(size_t)entry.offset], input.data.data(), input.data.size());
+        fileEntries.push_back(entry);
+    }
+
+    AssetArchiveHeader header = {};
+    header.magic = ASSET_ARCHIVE_MAGIC;
+    header.version = ASSET_ARCHIVE_VERSION;
+    header.entriesOffset = entriesOffset;
+    header.entryCount = fileEntries.size();
+    memcpy(&buffer[0], &header, sizeof(AssetArchiveHeader));
+    if (!fileEntries.empty()) {
+        memcpy(&buffer[entriesOffset], fileEntries.data(), fileEntries.size() * sizeof(AssetArchiveEntry));
+    }
+
+    FILE* out = fopen(path, "wb");
+    if (!out) return false;
+    bool written = fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size();
+    return fclose(out) == 0 && written;
+}
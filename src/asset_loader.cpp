@@ -0,0 +1,177 @@
+#include "asset_loader.h"
+#include "resource_cache.h"
+#include "sdf_font.h"
+#include <algorithm> // For std::max
+
+AssetLoader::AssetLoader(ResourceCache& resources, int workerCount) : resources(resources), stopping(false) {
+    if (workerCount < 0) {
+        workerCount = (int)std::thread::hardware_concurrency() - 1;
+    }
+    workerCount = std::max(workerCount, 1); // Decoding on the main thread would defeat the point
+    for (int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&AssetLoader::WorkerLoop, this);
+    }
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        queued.clear();
+    }
+    wakeWorkers.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (Job& job : decoded) {
+        FreeDecoded(job);
+    }
+    ReleaseAll();
+}
+
+void AssetLoader::Request(AssetKind kind, const char* path, int group) {
+    if (group >= (int)requestedPerGroup.size()) {
+        requestedPerGroup.resize(group + 1, 0);
+        donePerGroup.resize(group + 1, 0);
+    }
+    if (donePerGroup[group] == requestedPerGroup[group]) {
+        // Requested again after it finished, so progress counts from zero
+        requestedPerGroup[group] = 0;
+        donePerGroup[group] = 0;
+    }
+    requestedPerGroup[group]++;
+
+    Job job = {};
+    job.kind = kind;
+    job.path = path;
+    job.group = group;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued.push_back(std::move(job));
+    }
+    wakeWorkers.notify_one();
+}
+
+void AssetLoader::Update() {
+    std::vector<Job> finished;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.swap(decoded);
+    }
+
+    for (Job& job : finished) {
+        const char* path = job.path.c_str();
+        switch (job.kind) {
+        case AssetKind::TEXTURE:
+            if (job.image.data != NULL) {
+                Texture2D texture = LoadTextureFromImage(job.image);
+                UnloadImage(job.image);
+                texture = resources.InsertTexture(path, texture);
+                if (texture.id > 0) heldTextures.push_back({job.group, texture});
+            }
+            break;
+        case AssetKind::SOUND:
+            if (job.wave.data != NULL) {
+                Sound sound = LoadSoundFromWave(job.wave);
+                UnloadWave(job.wave);
+                sound = resources.InsertSound(path, sound);
+                if (sound.frameCount > 0) heldSounds.push_back({job.group, sound});
+            }
+            break;
+        case AssetKind::FONT:
+            if (job.font.glyphs != NULL) {
+                Font font = resources.InsertFont(path, SdfFont::Upload(job.font, job.image));
+                if (font.texture.id > 0) heldFonts.push_back({job.group, font});
+            }
+            break;
+        }
+        donePerGroup[job.group]++;
+    }
+}
+
+bool AssetLoader::IsGroupReady(int group) const {
+    if (group >= (int)requestedPerGroup.size()) return true;
+    return donePerGroup[group] == requestedPerGroup[group];
+}
+
+float AssetLoader::GetProgress(int group) const {
+    if (group >= (int)requestedPerGroup.size() || requestedPerGroup[group] == 0) return 1.0f;
+    return (float)donePerGroup[group] / (float)requestedPerGroup[group];
+}
+
+// Drops the held references in group (every group for -1), keeping the rest in order
+template <typename T, typename Release>
+static void ReleaseHeld(std::vector<std::pair<int, T>>& held, int group, Release release) {
+    size_t kept = 0;
+    for (size_t i = 0; i < held.size(); ++i) {
+        if (group < 0 || held[i].first == group) {
+            release(held[i].second);
+        } else {
+            held[kept++] = held[i];
+        }
+    }
+    held.resize(kept);
+}
+
+void AssetLoader::ReleaseGroup(int group) {
+    ReleaseHeld(heldTextures, group, [this](Texture2D texture) { resources.ReleaseTexture(texture); });
+    ReleaseHeld(heldSounds, group, [this](Sound sound) { resources.ReleaseSound(sound); });
+    ReleaseHeld(heldFonts, group, [this](Font font) { resources.ReleaseFont(font); });
+}
+
+void AssetLoader::ReleaseAll() {
+    ReleaseGroup(-1);
+}
+
+void AssetLoader::WorkerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeWorkers.wait(lock, [this] { return stopping || !queued.empty(); });
+            if (stopping) return;
+            job = std::move(queued.front());
+            queued.pop_front();
+        }
+
+        Decode(job);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) {
+                FreeDecoded(job);
+                return;
+            }
+            decoded.push_back(std::move(job));
+        }
+    }
+}
+
+// Only CPU-side raylib calls in here: file reads, decoders and image operations
+void AssetLoader::Decode(Job& job) const {
+    const AssetArchive& archive = resources.archive;
+    const char* path = job.path.c_str();
+    if (!archive.Exists(path)) return;
+
+    switch (job.kind) {
+    case AssetKind::TEXTURE:
+        job.image = archive.ReadImage(path);
+        break;
+    case AssetKind::SOUND:
+        job.wave = archive.ReadWave(path);
+        break;
+    case AssetKind::FONT:
+        archive.BakeFont(path, job.font, job.image);
+        break;
+    }
+}
+
+void AssetLoader::FreeDecoded(Job& job) {
+    if (job.image.data != NULL) UnloadImage(job.image);
+    if (job.wave.data != NULL) UnloadWave(job.wave);
+    if (job.font.glyphs != NULL) {
+        UnloadFontData(job.font.glyphs, job.font.glyphCount);
+        MemFree(job.font.recs);
+    }
+    job = {};
+}
@@ -0,0 +1,61 @@
+#include "collision_grid.h"
+#include "constants.h"
+#include <cmath>     // For floorf, ceilf
+#include <algorithm> // For std::max, std::min
+
+CollisionGrid::CollisionGrid() : radius(0.0f), width(0), height(0), wordsPerRow(0) {
+}
+
+void CollisionGrid::Bake(ArrayView<Rectangle> obstacles, float entityRadius, int worldWidth, int worldHeight) {
+    radius = entityRadius;
+    width = worldWidth;
+    height = worldHeight;
+    wordsPerRow = (width + 63) / 64;
+    storage.assign((size_t)wordsPerRow * height, 0);
+    bits = storage;
+
+    float safetyMargin = radius + COLLISION_SAFETY_MARGIN;
+    for (const auto& obs : obstacles) {
+        // A cell is blocked if any point inside it falls within the expanded obstacle
+        int x0 = (int)floorf(obs.x - safetyMargin);
+        int y0 = (int)floorf(obs.y - safetyMargin);
+        int x1 = (int)ceilf(obs.x + obs.width + safetyMargin);
+        int y1 = (int)ceilf(obs.y + obs.height + safetyMargin);
+        FillRect(x0, y0, x1, y1);
+    }
+}
+
+void CollisionGrid::Attach(float entityRadius, int gridWidth, int gridHeight, ArrayView<uint64_t> bakedBits) {
+    radius = entityRadius;
+    width = gridWidth;
+    height = gridHeight;
+    wordsPerRow = (width + 63) / 64;
+    storage.clear();
+    bits = bakedBits;
+}
+
+void CollisionGrid::FillRect(int x0, int y0, int x1, int y1) {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, width);
+    y1 = std::min(y1, height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    int firstWord = x0 >> 6;
+    int lastWord = (x1 - 1) >> 6;
+    uint64_t firstMask = ~0ULL << (x0 & 63);
+    uint64_t lastMask = ~0ULL >> (63 - ((x1 - 1) & 63));
+
+    for (int y = y0; y < y1; ++y) {
+        uint64_t* row = &storage[(size_t)y * wordsPerRow];
+        if (firstWord == lastWord) {
+            row[firstWord] |= firstMask & lastMask;
+            continue;
+        }
+        row[firstWord] |= firstMask;
+        for (int w = firstWord + 1; w < lastWord; ++w) {
+            row[w] = ~0ULL;
+        }
+        row[lastWord] |= lastMask;
+    }
+}
@@ -0,0 +1,160 @@
+#include "distance_field.h"
+#include "raymath.h"
+#include <cmath>     // For sqrtf, floorf, ceilf
+#include <algorithm> // For std::max, std::min
+#include <cstdint>
+
+namespace {
+
+const float EDT_INFINITY = 1e20f;
+
+// 1D squared Euclidean distance transform (Felzenszwalb & Huttenlocher) of f into d
+void DistanceTransform1D(const float* f, float* d, int n, int* v, float* z) {
+    int k = 0;
+    v[0] = 0;
+    z[0] = -EDT_INFINITY;
+    z[1] = EDT_INFINITY;
+    for (int q = 1; q < n; ++q) {
+        float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+        while (s <= z[k]) {
+            k--;
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = EDT_INFINITY;
+    }
+    k = 0;
+    for (int q = 0; q < n; ++q) {
+        while (z[k + 1] < q) k++;
+        d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
+
+// 2D squared distance (in cells) from every cell to the nearest cell where feature[cell] is set
+void DistanceTransform2D(const std::vector<uint8_t>& feature, int cols, int rows, std::vector<float>& out) {
+    int n = std::max(cols, rows);
+    std::vector<float> f(n), d(n), z(n + 1);
+    std::vector<int> v(n);
+    out.resize((size_t)cols * rows);
+
+    for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = feature[i] ? 0.0f : EDT_INFINITY;
+    }
+    for (int x = 0; x < cols; ++x) {
+        for (int y = 0; y < rows; ++y) f[y] = out[y * cols + x];
+        DistanceTransform1D(f.data(), d.data(), rows, v.data(), z.data());
+        for (int y = 0; y < rows; ++y) out[y * cols + x] = d[y];
+    }
+    for (int y = 0; y < rows; ++y) {
+        DistanceTransform1D(&out[y * cols], d.data(), cols, v.data(), z.data());
+        std::copy(d.begin(), d.begin() + cols, out.begin() + (size_t)y * cols);
+    }
+}
+
+} // namespace
+
+DistanceField::DistanceField() : cellSize(1.0f), cols(0), rows(0) {
+}
+
+void DistanceField::Bake(ArrayView<Rectangle> obstacles, int worldWidth, int worldHeight, float resolution) {
+    cellSize = resolution;
+    // One ring of padding cells around the world stands in for the world border
+    cols = (int)ceilf(worldWidth / cellSize) + 2;
+    rows = (int)ceilf(worldHeight / cellSize) + 2;
+    size_t cellCount = (size_t)cols * rows;
+
+    std::vector<uint8_t> solid(cellCount, 0);
+    for (int x = 0; x < cols; ++x) {
+        solid[x] = 1;
+        solid[(size_t)(rows - 1) * cols + x] = 1;
+    }
+    for (int y = 0; y < rows; ++y) {
+        solid[(size_t)y * cols] = 1;
+        solid[(size_t)y * cols + cols - 1] = 1;
+    }
+
+    // Rasterise obstacles by cell centre
+    for (const auto& obs : obstacles) {
+        int x0 = std::max(0, (int)ceilf(obs.x / cellSize - 0.5f) + 1);
+        int y0 = std::max(0, (int)ceilf(obs.y / cellSize - 0.5f) + 1);
+        int x1 = std::min(cols, (int)ceilf((obs.x + obs.width) / cellSize - 0.5f) + 1);
+        int y1 = std::min(rows, (int)ceilf((obs.y + obs.height) / cellSize - 0.5f) + 1);
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) {
+                solid[(size_t)y * cols + x] = 1;
+            }
+        }
+    }
+
+    std::vector<float> outside, inside;
+    DistanceTransform2D(solid, cols, rows, outside);
+    for (auto& cell : solid) cell = !cell;
+    DistanceTransform2D(solid, cols, rows, inside);
+
+    // Centre-to-centre distances overshoot the edge between two cells by half a cell
+    distanceStorage.resize(cellCount);
+    for (size_t i = 0; i < cellCount; ++i) {
+        if (outside[i] > 0.0f) {
+            distanceStorage[i] = (sqrtf(outside[i]) - 0.5f) * cellSize;
+        } else {
+            distanceStorage[i] = -(sqrtf(inside[i]) - 0.5f) * cellSize;
+        }
+    }
+    distance = distanceStorage;
+
+    ComputeGradients();
+}
+
+void DistanceField::Attach(float resolution, int fieldCols, int fieldRows, ArrayView<float> bakedDistance, ArrayView<Vector2> bakedGradient) {
+    cellSize = resolution;
+    cols = fieldCols;
+    rows = fieldRows;
+    distanceStorage.clear();
+    gradientStorage.clear();
+    distance = bakedDistance;
+    gradient = bakedGradient;
+}
+
+void DistanceField::ComputeGradients() {
+    gradientStorage.assign(distance.size(), {0, 0});
+    for (int y = 1; y < rows - 1; ++y) {
+        for (int x = 1; x < cols - 1; ++x) {
+            size_t i = (size_t)y * cols + x;
+            Vector2 g = {
+                distance[i + 1] - distance[i - 1],
+                distance[i + cols] - distance[i - cols]
+            };
+            gradientStorage[i] = Vector2Normalize(g);
+        }
+    }
+    gradient = gradientStorage;
+}
+
+float DistanceField::Sample(Vector2 position) const {
+    if (distance.empty()) return 0.0f;
+
+    // Cell centres sit at (index - 1 + 0.5) * cellSize because of the padding ring
+    float gx = position.x / cellSize + 0.5f;
+    float gy = position.y / cellSize + 0.5f;
+    gx = Clamp(gx, 0.0f, (float)(cols - 1) - 0.001f);
+    gy = Clamp(gy, 0.0f, (float)(rows - 1) - 0.001f);
+    int x = (int)gx;
+    int y = (int)gy;
+    float tx = gx - x;
+    float ty = gy - y;
+
+    const float* row0 = &distance[(size_t)y * cols + x];
+    const float* row1 = row0 + cols;
+    float top = row0[0] + (row0[1] - row0[0]) * tx;
+    float bottom = row1[0] + (row1[1] - row1[0]) * tx;
+    return top + (bottom - top) * ty;
+}
+
+Vector2 DistanceField::SampleGradient(Vector2 position) const {
+    if (gradient.empty()) return {0, 0};
+    int x = (int)Clamp(position.x / cellSize + 1.0f, 0.0f, (float)(cols - 1));
+    int y = (int)Clamp(position.y / cellSize + 1.0f, 0.0f, (float)(rows - 1));
+    return gradient[(size_t)y * cols + x];
+}
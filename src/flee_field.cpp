@@ -0,0 +1,118 @@
+#include "flee_field.h"
+#include "pathfinder.h"
+#include "constants.h"
+#include "raymath.h"
+#include <algorithm> // For std::push_heap, std::pop_heap
+#include <climits>   // For INT_MAX
+
+namespace {
+
+const int STRAIGHT_COST = 10;
+const int DIAGONAL_COST = 14;
+const int UNREACHABLE = INT_MAX / 2;
+
+const int NEIGHBOR_OFFSETS[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+// Same movement rules as the pathfinder: 8-connected, no corner cutting
+bool CanStep(const Pathfinder& navGrid, int cx, int cy, int dx, int dy) {
+    if (!navGrid.IsWalkable(cx + dx, cy + dy)) return false;
+    if (dx != 0 && dy != 0) {
+        return navGrid.IsWalkable(cx + dx, cy) && navGrid.IsWalkable(cx, cy + dy);
+    }
+    return true;
+}
+
+} // namespace
+
+FleeField::FleeField() : sourceCell(-1) {
+}
+
+void FleeField::Reset() {
+    sourceCell = -1;
+}
+
+void FleeField::Update(const Pathfinder& navGrid, Vector2 seekerPosition) {
+    if (navGrid.walkable.empty()) return;
+
+    int seekerCell = navGrid.CellIndex(seekerPosition);
+    if (seekerCell == sourceCell) return; // Seeker hasn't crossed into a new cell, field is still current
+    sourceCell = seekerCell;
+
+    size_t cellCount = navGrid.walkable.size();
+    distance.assign(cellCount, UNREACHABLE);
+    fleeCost.resize(cellCount);
+    nextCell.resize(cellCount);
+
+    // Pass 1: distance from the seeker
+    queue.clear();
+    distance[seekerCell] = 0;
+    queue.push_back({0, seekerCell});
+    Relax(navGrid, distance);
+
+    // Pass 2: invert, then rescan so cells in dead ends drain towards the exits instead of the back wall
+    queue.clear();
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+        if (distance[cell] >= UNREACHABLE) {
+            fleeCost[cell] = UNREACHABLE;
+            continue;
+        }
+        fleeCost[cell] = -(int)(distance[cell] * FLEE_FIELD_COEFFICIENT);
+        queue.push_back({fleeCost[cell], (int)cell});
+    }
+    std::make_heap(queue.begin(), queue.end());
+    Relax(navGrid, fleeCost);
+
+    BuildNextCells(navGrid);
+}
+
+void FleeField::Relax(const Pathfinder& navGrid, std::vector<int>& costs) {
+    while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end());
+        QueueNode node = queue.back();
+        queue.pop_back();
+        if (node.cost > costs[node.cell]) continue; // Stale entry
+
+        int cx = node.cell % navGrid.cols;
+        int cy = node.cell / navGrid.cols;
+        for (const auto& offset : NEIGHBOR_OFFSETS) {
+            if (!CanStep(navGrid, cx, cy, offset[0], offset[1])) continue;
+            int neighbor = (cy + offset[1]) * navGrid.cols + (cx + offset[0]);
+            int cost = node.cost + ((offset[0] != 0 && offset[1] != 0) ? DIAGONAL_COST : STRAIGHT_COST);
+            if (cost < costs[neighbor]) {
+                costs[neighbor] = cost;
+                queue.push_back({cost, neighbor});
+                std::push_heap(queue.begin(), queue.end());
+            }
+        }
+    }
+}
+
+void FleeField::BuildNextCells(const Pathfinder& navGrid) {
+    // Point each cell at its cheapest neighbour
+    for (int cy = 0; cy < navGrid.rows; ++cy) {
+        for (int cx = 0; cx < navGrid.cols; ++cx) {
+            int cell = cy * navGrid.cols + cx;
+            nextCell[cell] = -1;
+            if (!navGrid.walkable[cell] || fleeCost[cell] >= UNREACHABLE) continue;
+
+            int bestCost = fleeCost[cell];
+            for (const auto& offset : NEIGHBOR_OFFSETS) {
+                if (!CanStep(navGrid, cx, cy, offset[0], offset[1])) continue;
+                int neighbor = (cy + offset[1]) * navGrid.cols + (cx + offset[0]);
+                if (fleeCost[neighbor] < bestCost) {
+                    bestCost = fleeCost[neighbor];
+                    nextCell[cell] = neighbor;
+                }
+            }
+        }
+    }
+}
+
+Vector2 FleeField::GetDirection(const Pathfinder& navGrid, Vector2 position) const {
+    if (sourceCell < 0 || nextCell.empty()) return {0, 0};
+    int cell = navGrid.CellIndex(position);
+    if (nextCell[cell] < 0) return {0, 0};
+
+    // Steer at the centre of the downhill cell, which keeps hiders off the walls
+    return Vector2Normalize(Vector2Subtract(navGrid.CellCenter(nextCell[cell]), position));
+}
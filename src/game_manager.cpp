@@ -1,17 +1,53 @@
 #include "game_manager.h"
 #include "constants.h"
+#include "sdf_font.h"
 #include "raymath.h"
-#include <cstdlib>   // For srand, rand
-#include <ctime>     // For time for srand
+#include <ctime>     // For time, the first match seed
 #include <algorithm> // For std::all_of
 #include <cstdio>    // For snprintf
 
-GameManager::GameManager() : currentScreen(GameScreen::MAIN_MENU), currentPhase(GamePhase::HIDING),
-                             gameTimer(0.0f), hidersRemaining(0), playerWon(false),
-                             quitGame(false), restartGameFlag(false), lastGameTime(0.0f), hidingPhaseElapsed(0.0f) {
-    srand((unsigned int)time(NULL));
-    uiManager.LoadAssets();
-    gameMap.Load();
+static AssetGroup AssetGroupFor(GameScreen screen) {
+    switch (screen) {
+        case GameScreen::MAIN_MENU: return AssetGroup::MAIN_MENU;
+        case GameScreen::HOW_TO_PLAY: return AssetGroup::HOW_TO_PLAY;
+        case GameScreen::IN_GAME: return AssetGroup::IN_GAME;
+        case GameScreen::PAUSE_MENU: return AssetGroup::IN_GAME;
+        case GameScreen::GAME_OVER: return AssetGroup::GAME_OVER;
+        default: return AssetGroup::SHARED;
+    }
+}
+
+// Where a screen most often leads, worth loading while the player is still on it
+static GameScreen LikelyNextScreen(GameScreen screen) {
+    switch (screen) {
+        case GameScreen::IN_GAME: return GameScreen::GAME_OVER;
+        case GameScreen::PAUSE_MENU: return GameScreen::GAME_OVER;
+        case GameScreen::HOW_TO_PLAY: return GameScreen::MAIN_MENU;
+        default: return GameScreen::IN_GAME; // Play from the menu, or Play Again
+    }
+}
+
+// Starts on the menu with nothing loaded; the first Update notices and shows LOADING until it is
+GameManager::GameManager() : currentScreen(GameScreen::MAIN_MENU), screenAfterLoading(GameScreen::MAIN_MENU),
+                             shownScreen(GameScreen::LOADING), assetLoader(resources), assetBudget(ASSET_BUDGET_BYTES),
+                             prefetchAssets(ASSET_PREFETCH), characterAtlas(&resources.archive), renderAlpha(0.0f),
+                             seeker(&keyboardSeeker), playingReplay(false), playbackSpeed(1.0f),
+                             quitGame(false), restartGameFlag(false) {
+#ifdef HIDENSEEK_PROFILE
+    showProfiler = false;
+#endif
+    sim.matchSeed = (uint64_t)time(NULL); // InitGame derives the first match seed from this
+    if (resources.archive.Open(ASSET_ARCHIVE_PATH)) {
+        TraceLog(LOG_INFO, "RESOURCES: Reading from %s", ASSET_ARCHIVE_PATH);
+    }
+    for (AssetGroupStatus& group : assetGroups) {
+        group = {AssetGroupState::UNLOADED, 0.0};
+    }
+    sim.LoadMap();
+    sim.player.LoadAssets(characterAtlas);
+    sim.hiders.LoadSkins(characterAtlas);
+    characterAtlas.Build();
+    sim.hiders.threadPool = &threadPool;
     
     // Initialize camera
     camera = {0};
@@ -31,143 +67,50 @@ GameManager::GameManager() : currentScreen(GameScreen::MAIN_MENU), currentPhase(
     tagSound = {0};
 
     // Load phase music
-    if (FileExists("countdown.mp3")) {
-        hidingPhaseMusic = LoadMusicStream("countdown.mp3");
-        SetMusicVolume(hidingPhaseMusic, 0.5f);
-    }
-    if (FileExists("ingame.mp3")) {
-        seekingPhaseMusic = LoadMusicStream("ingame.mp3");
-        SetMusicVolume(seekingPhaseMusic, 0.5f);
-    }
-    // Load sound effects
-    if (FileExists("victory.mp3")) {
-        victorySound = LoadSound("victory.mp3");
-        SetSoundVolume(victorySound, 0.7f);
-    }
-    if (FileExists("game_over.mp3")) {
-        gameOverSound = LoadSound("game_over.mp3");
-        SetSoundVolume(gameOverSound, 0.7f);
-    }
-    if (FileExists("tag.wav")) {
-        tagSound = LoadSound("tag.wav");
-        SetSoundVolume(tagSound, 0.5f);
-    }
+    hidingPhaseMusic = resources.archive.OpenMusic("countdown.mp3");
+    if (hidingPhaseMusic.stream.buffer != NULL) SetMusicVolume(hidingPhaseMusic, 0.5f);
+    seekingPhaseMusic = resources.archive.OpenMusic("ingame.mp3");
+    if (seekingPhaseMusic.stream.buffer != NULL) SetMusicVolume(seekingPhaseMusic, 0.5f);
+    // Sound effects come with the IN_GAME asset group
 }
 
 GameManager::~GameManager() {
-    uiManager.UnloadAssets();
-    gameMap.Unload();
+    uiManager.UnloadAssets(resources);
+    SdfFont::UnloadShader();
+    sim.gameMap.Unload(resources);
+    characterAtlas.Unload();
     UnloadRenderTexture(visionOverlay);
     if (hidingPhaseMusic.stream.buffer != NULL) UnloadMusicStream(hidingPhaseMusic);
     if (seekingPhaseMusic.stream.buffer != NULL) UnloadMusicStream(seekingPhaseMusic);
-    if (victorySound.frameCount > 0) UnloadSound(victorySound);
-    if (gameOverSound.frameCount > 0) UnloadSound(gameOverSound);
-    if (tagSound.frameCount > 0) UnloadSound(tagSound);
+    resources.ReleaseSound(victorySound);
+    resources.ReleaseSound(gameOverSound);
+    resources.ReleaseSound(tagSound);
 }
 
-void GameManager::ResetGameValues() {
-    player.rotation = 0.0f;
-    player.showAlert = false;
-
-    // Define possible corner spawn points with padding
-    float padding = PLAYER_RADIUS + 50.0f; // Same padding as before
-    std::vector<Vector2> cornerSpawnPoints = {
-        {padding, padding},                                      // Top-left
-        {SCREEN_WIDTH - padding, padding},                     // Top-right
-        {padding, SCREEN_HEIGHT - padding},                    // Bottom-left
-        {SCREEN_WIDTH - padding, SCREEN_HEIGHT - padding}      // Bottom-right
-    };
-
-    Vector2 playerSpawnPos = {0, 0};
-    bool spawnPosFound = false;
-    int attempts = 0;
-    const int maxAttempts = 10; // Try up to 10 times to find a valid corner
-
-    // Randomly select a corner and check if it's valid
-    while (!spawnPosFound && attempts < maxAttempts) {
-        int cornerIndex = rand() % cornerSpawnPoints.size();
-        Vector2 potentialPos = cornerSpawnPoints[cornerIndex];
-
-        if (gameMap.IsPositionValid(potentialPos, PLAYER_RADIUS)) {
-            playerSpawnPos = potentialPos;
-            spawnPosFound = true;
-        }
-        attempts++;
-    }
-
-    // Fallback if no valid corner found (shouldn't happen with reasonable maps)
-    if (!spawnPosFound) {
-        playerSpawnPos = {padding, padding}; // Default to top-left if no valid corner found
+void GameManager::InitGame() {
+    // Restarting after watching a replay goes back to playing
+    if (playingReplay) {
+        playingReplay = false;
+        seeker = &keyboardSeeker;
+        sim.config = SimConfig();
     }
 
-    player.gameManager = this; // Set the game manager pointer
-    player.Init(playerSpawnPos); // Initialize player at the selected valid position
-
-    hiders.assign(NUM_HIDERS, Hider());
-    std::vector<Vector2> startingPositions;
-    for (int i = 0; i < NUM_HIDERS; ++i) {
-        Vector2 pos;
-        bool positionOk;
-        int attempts = 0;
-        const int maxSpawnAttempts = 100; // Limit attempts to prevent infinite loops
-        do {
-            positionOk = true;
-            pos = {(float)(rand() % (SCREEN_WIDTH - 200) + 100), (float)(rand() % (SCREEN_HEIGHT - 200) + 100)}; // Generate position away from edges
-            attempts++;
-
-            // Check distance from player
-            if (Vector2DistanceSqr(pos, player.position) < (PLAYER_RADIUS + HIDER_RADIUS + 50) * (PLAYER_RADIUS + HIDER_RADIUS + 50)) {
-                positionOk = false;
-                continue;
-            }
-
-            // Check distance from already assigned hider starting positions
-            for(const auto& existingPos : startingPositions) {
-                if (Vector2DistanceSqr(pos, existingPos) < (HIDER_RADIUS * 4) * (HIDER_RADIUS * 4)) {
-                    positionOk = false;
-                    break;
-                }
-            }
-            if (!positionOk) continue;
-
-            // Check validity against map obstacles
-            if (!gameMap.IsPositionValid(pos, HIDER_RADIUS)) {
-                positionOk = false;
-            }
-
-        } while(!positionOk && attempts < maxSpawnAttempts);
-
-        if (attempts >= maxSpawnAttempts) {
-            // Fallback: place at a default spot or allow potentially invalid spot (depending on desired game behavior)
-            // For now, we'll just use the last attempted position, which might be invalid.
-            // A better approach might be to place them near the player's start or a known valid spot.
-        }
-
-        startingPositions.push_back(pos);
-        hiders[i].Init(pos, gameMap, i); // Pass the hider ID (0-4) to Init
-        hiders[i].gameManager = this; // Set the game manager pointer
-        // Explicitly ensure these are reset if Init doesn't cover them fully for a *new game* scenario
-        hiders[i].isTagged = false; 
-        hiders[i].hidingState = HiderHidingFSMState::SCOUTING; 
-        hiders[i].seekingState = HiderSeekingFSMState::IDLING;
-    }
-
-    hidersRemaining = NUM_HIDERS;
-    playerWon = false;
-    StartHidingPhase();         // Sets gameTimer, currentPhase, and hider FSM states
-    hidingPhaseElapsed = 0.0f;  // << CRITICAL: Reset this for the "Close Your Eyes" screen
-    lastGameTime = 0.0f;
-    // restartGameFlag is reset after use in Update()
+    // Each new match derives its seed from the last, so a whole session replays from the first seed
+    InitGame(RandomStream(sim.matchSeed, RANDOM_STREAM_NEXT_MATCH).NextU64());
 }
 
-void GameManager::InitGame() {
-    ResetGameValues();
-}
-
-void GameManager::StartHidingPhase() {
-    currentPhase = GamePhase::HIDING;
-    gameTimer = HIDING_PHASE_DURATION;
-    hidingPhaseElapsed = 0.0f;
+void GameManager::InitGame(uint64_t seed) {
+    sim.Reset(seed);
+    simClock.Reset();
+    renderAlpha = 0.0f;
+    keyboardSeeker.Reset();
+    seekerBot.Reset();
+    replaySeeker.Reset();
+    rewindBuffer.Clear();
+    saveState.clear();
+    if (!playingReplay) {
+        replay.Begin(seed, sim.config, sim.gameMap.layoutHash);
+    }
 
     // Stop seeking phase music if playing
     if (seekingPhaseMusic.stream.buffer != NULL) {
@@ -178,37 +121,30 @@ void GameManager::StartHidingPhase() {
     if (hidingPhaseMusic.stream.buffer != NULL) {
         PlayMusicStream(hidingPhaseMusic);
     }
-
-    for (auto& hider : hiders) {
-        if (!hider.isTagged) {
-            hider.hidingState = HiderHidingFSMState::SCOUTING;
-        }
-    }
 }
 
-void GameManager::StartSeekingPhase() {
-    currentPhase = GamePhase::SEEKING;
-    gameTimer = SEEKING_PHASE_DURATION;
-
-    // Stop hiding phase music if playing
-    if (hidingPhaseMusic.stream.buffer != NULL) {
-        StopMusicStream(hidingPhaseMusic);
-    }
-
-    // Start seeking phase music
-    if (seekingPhaseMusic.stream.buffer != NULL) {
-        PlayMusicStream(seekingPhaseMusic);
+bool GameManager::StartReplay(const char* path, float speed) {
+    if (!replay.Load(path)) return false;
+    if (!replay.IsForMap(sim.gameMap.layoutHash)) {
+        TraceLog(LOG_WARNING, "REPLAY: %s was recorded on a different map", path);
+        return false;
     }
 
-    for (auto& hider : hiders) {
-        if (!hider.isTagged) {
-            hider.seekingState = HiderSeekingFSMState::IDLING;
-        }
-    }
+    playingReplay = true;
+    playbackSpeed = speed > 0.0f ? speed : 1.0f;
+    sim.config = replay.config;
+    replaySeeker.Start(&replay);
+    seeker = &replaySeeker;
+    InitGame(replay.seed);
+    currentScreen = GameScreen::IN_GAME;
+    return true;
 }
 
 void GameManager::Update() {
     GameScreen screenAtFrameStart = this->currentScreen; // Capture screen state BEFORE UI might change it in Draw()
+    UpdateProfiler();
+    UpdateLoading();
+    CheckScreenChange(); // The menus switch screens while drawing
 
     switch (this->currentScreen) {
         case GameScreen::MAIN_MENU:
@@ -244,8 +180,11 @@ void GameManager::Update() {
         this->currentScreen = GameScreen::IN_GAME; // Ensure we go to game screen
     }
 
+    CheckScreenChange();
+
     // Stop all sounds when transitioning to main menu
-    if (this->currentScreen == GameScreen::MAIN_MENU) {
+    bool towardsMainMenu = currentScreen == GameScreen::LOADING && screenAfterLoading == GameScreen::MAIN_MENU;
+    if (this->currentScreen == GameScreen::MAIN_MENU || towardsMainMenu) {
         // Stop phase music
         if (hidingPhaseMusic.stream.buffer != NULL) {
             StopMusicStream(hidingPhaseMusic);
@@ -263,133 +202,314 @@ void GameManager::Update() {
     }
 }
 
+void GameManager::UpdateLoading() {
+    assetLoader.Update();
+    for (int i = 0; i < (int)AssetGroup::COUNT; ++i) {
+        if (assetGroups[i].state == AssetGroupState::LOADING && assetLoader.IsGroupReady(i)) {
+            LoadAssetGroup((AssetGroup)i);
+        }
+    }
+
+    if (currentScreen == GameScreen::LOADING && IsScreenReady(screenAfterLoading)) {
+        currentScreen = screenAfterLoading;
+    }
+}
+
+void GameManager::CheckScreenChange() {
+    if (currentScreen == shownScreen) return;
+
+    if (currentScreen != GameScreen::LOADING && !IsScreenReady(currentScreen)) {
+        RequestAssetGroup(AssetGroup::SHARED);
+        RequestAssetGroup(AssetGroupFor(currentScreen));
+        screenAfterLoading = currentScreen;
+        currentScreen = GameScreen::LOADING;
+    }
+
+    GameScreen target = (currentScreen == GameScreen::LOADING) ? screenAfterLoading : currentScreen;
+    assetGroups[(int)AssetGroupFor(target)].lastUsed = GetTime();
+    if (prefetchAssets) {
+        RequestAssetGroup(AssetGroupFor(LikelyNextScreen(target)));
+    }
+    shownScreen = currentScreen;
+    EvictAssets(); // What the last screen kept may be evictable now
+}
+
+bool GameManager::IsScreenReady(GameScreen screen) const {
+    return assetGroups[(int)AssetGroup::SHARED].state == AssetGroupState::LOADED &&
+           assetGroups[(int)AssetGroupFor(screen)].state == AssetGroupState::LOADED;
+}
+
+void GameManager::RequestAssetGroup(AssetGroup group) {
+    AssetGroupStatus& status = assetGroups[(int)group];
+    if (status.state != AssetGroupState::UNLOADED) return;
+
+    int loaderGroup = (int)group;
+    switch (group) {
+        case AssetGroup::SHARED:
+            uiManager.RequestSharedAssets(assetLoader, loaderGroup);
+            break;
+        case AssetGroup::MAIN_MENU:
+            uiManager.RequestScreenAssets(GameScreen::MAIN_MENU, assetLoader, loaderGroup);
+            break;
+        case AssetGroup::HOW_TO_PLAY:
+            uiManager.RequestScreenAssets(GameScreen::HOW_TO_PLAY, assetLoader, loaderGroup);
+            break;
+        case AssetGroup::IN_GAME:
+            sim.gameMap.RequestTextures(assetLoader, loaderGroup);
+            assetLoader.Request(AssetKind::SOUND, "victory.mp3", loaderGroup);
+            assetLoader.Request(AssetKind::SOUND, "game_over.mp3", loaderGroup);
+            assetLoader.Request(AssetKind::SOUND, "tag.wav", loaderGroup);
+            break;
+        case AssetGroup::GAME_OVER:
+            uiManager.RequestScreenAssets(GameScreen::GAME_OVER, assetLoader, loaderGroup);
+            break;
+        default:
+            break;
+    }
+    status.state = AssetGroupState::LOADING;
+    status.lastUsed = GetTime();
+}
+
+void GameManager::LoadAssetGroup(AssetGroup group) {
+    // The loader already put these in the cache, so the acquires here don't decode anything
+    switch (group) {
+        case AssetGroup::SHARED:
+            uiManager.LoadSharedAssets(resources);
+            break;
+        case AssetGroup::MAIN_MENU:
+            uiManager.LoadScreenAssets(GameScreen::MAIN_MENU, resources);
+            break;
+        case AssetGroup::HOW_TO_PLAY:
+            uiManager.LoadScreenAssets(GameScreen::HOW_TO_PLAY, resources);
+            break;
+        case AssetGroup::IN_GAME:
+            sim.gameMap.LoadTextures(resources);
+            victorySound = resources.AcquireSound("victory.mp3");
+            if (victorySound.frameCount > 0) SetSoundVolume(victorySound, 0.7f);
+            gameOverSound = resources.AcquireSound("game_over.mp3");
+            if (gameOverSound.frameCount > 0) SetSoundVolume(gameOverSound, 0.7f);
+            tagSound = resources.AcquireSound("tag.wav");
+            if (tagSound.frameCount > 0) SetSoundVolume(tagSound, 0.5f);
+            break;
+        case AssetGroup::GAME_OVER:
+            uiManager.LoadScreenAssets(GameScreen::GAME_OVER, resources);
+            break;
+        default:
+            break;
+    }
+    assetLoader.ReleaseGroup((int)group);
+    assetGroups[(int)group].state = AssetGroupState::LOADED;
+    EvictAssets();
+}
+
+void GameManager::UnloadAssetGroup(AssetGroup group) {
+    switch (group) {
+        case AssetGroup::MAIN_MENU:
+            uiManager.UnloadScreenAssets(GameScreen::MAIN_MENU, resources);
+            break;
+        case AssetGroup::HOW_TO_PLAY:
+            uiManager.UnloadScreenAssets(GameScreen::HOW_TO_PLAY, resources);
+            break;
+        case AssetGroup::IN_GAME:
+            sim.gameMap.Unload(resources);
+            resources.ReleaseSound(victorySound);
+            resources.ReleaseSound(gameOverSound);
+            resources.ReleaseSound(tagSound);
+            victorySound = {0};
+            gameOverSound = {0};
+            tagSound = {0};
+            break;
+        case AssetGroup::GAME_OVER:
+            uiManager.UnloadScreenAssets(GameScreen::GAME_OVER, resources);
+            break;
+        default:
+            return; // SHARED stays for the whole run
+    }
+    assetGroups[(int)group].state = AssetGroupState::UNLOADED;
+}
+
+size_t GameManager::GetResidentAssetBytes() const {
+    return resources.GetResidentBytes() + sim.gameMap.GetResidentBytes();
+}
+
+void GameManager::EvictAssets() {
+    // Never the screen being shown or waited for, nor what was prefetched for it
+    GameScreen target = (currentScreen == GameScreen::LOADING) ? screenAfterLoading : currentScreen;
+    AssetGroup keep = AssetGroupFor(target);
+    AssetGroup keepNext = prefetchAssets ? AssetGroupFor(LikelyNextScreen(target)) : keep;
+
+    while (GetResidentAssetBytes() > assetBudget) {
+        int oldest = -1;
+        for (int i = (int)AssetGroup::SHARED + 1; i < (int)AssetGroup::COUNT; ++i) {
+            if (assetGroups[i].state != AssetGroupState::LOADED) continue;
+            if (i == (int)keep || i == (int)keepNext) continue;
+            if (oldest < 0 || assetGroups[i].lastUsed < assetGroups[oldest].lastUsed) oldest = i;
+        }
+        if (oldest < 0) {
+            TraceLog(LOG_WARNING, "RESOURCES: %d KiB in use, over the %d KiB budget with nothing left to evict",
+                     (int)(GetResidentAssetBytes() / 1024), (int)(assetBudget / 1024));
+            return;
+        }
+        UnloadAssetGroup((AssetGroup)oldest);
+    }
+}
+
 void GameManager::UpdateMainMenu() { /* Stub */ }
 void GameManager::UpdateHowToPlay() { /* Stub */ }
 void GameManager::UpdatePauseMenu() { /* Stub */ }
 void GameManager::UpdateGameOver() { /* Stub */ }
 
+void GameManager::UpdateProfiler() {
+#ifdef HIDENSEEK_PROFILE
+    if (IsKeyPressed(KEY_F3)) {
+        showProfiler = !showProfiler;
+    }
+    if (IsKeyPressed(KEY_F4)) {
+        const char* path = TextFormat("trace_%lld.json", (long long)time(NULL));
+        if (Profiler::WriteTrace(path)) {
+            TraceLog(LOG_INFO, "PROFILER: Wrote %s", path);
+        } else {
+            TraceLog(LOG_WARNING, "PROFILER: Could not write %s", path);
+        }
+    }
+#endif
+}
+
 void GameManager::UpdateInGame() {
     if (IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_P)) {
         currentScreen = GameScreen::PAUSE_MENU;
         return;
     }
 
-    float deltaTime = GetFrameTime();
+    // Update current phase music
+    {
+        PROFILE_SCOPE("Music stream");
+        if (sim.currentPhase == GamePhase::HIDING && hidingPhaseMusic.stream.buffer != NULL) {
+            UpdateMusicStream(hidingPhaseMusic);
+        } else if (sim.currentPhase == GamePhase::SEEKING && seekingPhaseMusic.stream.buffer != NULL) {
+            UpdateMusicStream(seekingPhaseMusic);
+        }
+    }
 
-    // Update camera to follow player
-    camera.target = player.position;
+    // Hand the seeker to the bot and back; the bot picks up from wherever the player left it
+    if (IsKeyPressed(KEY_F2) && !playingReplay) {
+        seeker = (seeker == &keyboardSeeker) ? (SeekerController*)&seekerBot : (SeekerController*)&keyboardSeeker;
+        seekerBot.Reset();
+    }
+    keyboardSeeker.Poll();
 
-    // Update current phase music
-    if (currentPhase == GamePhase::HIDING && hidingPhaseMusic.stream.buffer != NULL) {
-        UpdateMusicStream(hidingPhaseMusic);
-    } else if (currentPhase == GamePhase::SEEKING && seekingPhaseMusic.stream.buffer != NULL) {
-        UpdateMusicStream(seekingPhaseMusic);
+#ifdef DEBUG
+    if (IsKeyPressed(KEY_F6)) {
+        sim.gameMap.showObstacles = !sim.gameMap.showObstacles; // Collision rectangles over the map
     }
+#endif
 
-    if (currentPhase == GamePhase::HIDING) {
-        hidingPhaseElapsed += deltaTime;
+    // Quick save and load within the current match
+    GamePhase phaseBefore = sim.currentPhase;
+    if (IsKeyPressed(KEY_F5)) {
+        saveState.resize(sim.GetSnapshotSize());
+        sim.SaveSnapshot(saveState.data());
+    }
+    if (IsKeyPressed(KEY_F9) && !saveState.empty()) {
+        sim.LoadSnapshot(saveState.data());
+        rewindBuffer.Clear();
+        OnWorldRestored(phaseBefore);
+    }
 
-        // Option to skip hiding phase for debugging/testing
-        if (IsKeyPressed(KEY_SPACE)) {
-            StartSeekingPhase();
-            return;
+    // Holding Backspace runs the match backwards, one snapshot per tick
+    bool rewinding = IsKeyDown(KEY_BACKSPACE);
+    int ticks = simClock.Advance(GetFrameTime(), playingReplay ? playbackSpeed : 1.0f);
+    for (int tick = 0; tick < ticks; ++tick) {
+        if (rewinding) {
+            if (!rewindBuffer.Pop(sim)) break;
+            continue;
         }
+        rewindBuffer.Push(sim);
 
-        // Hiders find spots during the entire HIDING_PHASE_DURATION
-        for (auto& hider : hiders) {
-            if (!hider.isTagged) {
-                hider.Update(deltaTime, currentPhase, player, gameMap, hiders);
-            }
+        SeekerInput input = seeker->NextInput(sim);
+        if (!playingReplay) {
+            replay.Record(input);
         }
+        sim.Tick(simClock.tickDelta, input);
 
-        gameTimer -= deltaTime;
+        if (sim.seekingPhaseStarted) {
+            // Stop hiding phase music if playing
+            if (hidingPhaseMusic.stream.buffer != NULL) {
+                StopMusicStream(hidingPhaseMusic);
+            }
 
-        if (gameTimer <= 0) {
-            StartSeekingPhase();
+            // Start seeking phase music
+            if (seekingPhaseMusic.stream.buffer != NULL) {
+                PlayMusicStream(seekingPhaseMusic);
+            }
+        }
+        if (sim.tagEvents > 0 && tagSound.frameCount > 0) {
+            PlaySound(tagSound);
+        }
+        if (sim.IsOver()) {
+            EndMatch();
+            break;
         }
-        return;
     }
+    if (rewinding) {
+        OnWorldRestored(phaseBefore);
+    }
+    renderAlpha = simClock.GetAlpha();
 
-    // --- SEEKING PHASE ---
-    if (currentPhase == GamePhase::SEEKING) {
-        gameTimer -= deltaTime;
-        player.Update(deltaTime, gameMap, hiders);
-
-        hidersRemaining = 0;
-        bool playerTaggedByHider = false;
-
-        for (auto& hider : hiders) {
-            if (!hider.isTagged) {
-                hider.Update(deltaTime, currentPhase, player, gameMap, hiders);
-                hidersRemaining++;
-
-                if (hider.seekingState == HiderSeekingFSMState::ATTACKING) {
-                    float distanceToPlayer = Vector2Distance(player.position, hider.position);
-                    float collisionDistance = HIDER_RADIUS + PLAYER_RADIUS;
-                    if (distanceToPlayer <= collisionDistance) {
-                        playerTaggedByHider = true;
-                    }
-                }
-            }
-        }
+    // Update camera to follow player
+    camera.target = sim.player.GetRenderPosition(renderAlpha);
+}
 
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || IsKeyPressed(KEY_ENTER)) {
-            bool taggedAnyHider = false;
-            for (auto& hider : hiders) {
-                if (player.CanTag(hider)) {
-                    hider.isTagged = true;
-                    taggedAnyHider = true;
-                }
-            }
-            
-            // Only play tag sound if we actually tagged someone
-            if (taggedAnyHider && tagSound.frameCount > 0) {
-                PlaySound(tagSound);
-            }
+void GameManager::EndMatch() {
+    currentScreen = GameScreen::GAME_OVER;
+    if (playingReplay) {
+        if ((int)sim.result != replay.result || sim.tickCount != replay.tickCount) {
+            TraceLog(LOG_WARNING, "REPLAY: Playback ended differently from the recording (result %d at tick %d, recorded %d at tick %d)",
+                     (int)sim.result, sim.tickCount, replay.result, replay.tickCount);
         }
-        
-        hidersRemaining = 0;
-        for(const auto& hider : hiders) {
-            if (!hider.isTagged) hidersRemaining++;
+    } else {
+        SaveReplay();
+    }
+    if (seekingPhaseMusic.stream.buffer != NULL) {
+        StopMusicStream(seekingPhaseMusic);
+    }
+    if (sim.PlayerWon()) {
+        if (victorySound.frameCount > 0) {
+            PlaySound(victorySound);
         }
+    } else if (gameOverSound.frameCount > 0) {
+        PlaySound(gameOverSound);
+    }
+}
 
-        CheckWinLossConditions(playerTaggedByHider);
+void GameManager::OnWorldRestored(GamePhase phaseBefore) {
+    // Input from here on replaces whatever was recorded after this tick
+    if (playingReplay) {
+        replaySeeker.SeekTo(sim.tickCount);
+    } else {
+        replay.TruncateTo(sim.tickCount);
+    }
+    seekerBot.Reset();
+
+    if (sim.currentPhase == phaseBefore) return;
+    Music& stopMusic = sim.currentPhase == GamePhase::HIDING ? seekingPhaseMusic : hidingPhaseMusic;
+    Music& startMusic = sim.currentPhase == GamePhase::HIDING ? hidingPhaseMusic : seekingPhaseMusic;
+    if (stopMusic.stream.buffer != NULL) {
+        StopMusicStream(stopMusic);
+    }
+    if (startMusic.stream.buffer != NULL && !IsMusicStreamPlaying(startMusic)) {
+        PlayMusicStream(startMusic);
     }
 }
 
-void GameManager::CheckWinLossConditions(bool playerGotTagged) {
-    if (currentPhase == GamePhase::SEEKING && currentScreen != GameScreen::GAME_OVER) { 
-        if (hidersRemaining == 0) {
-            playerWon = true;
-            lastGameTime = SEEKING_PHASE_DURATION - gameTimer;
-            currentScreen = GameScreen::GAME_OVER;
-            if (seekingPhaseMusic.stream.buffer != NULL) {
-                StopMusicStream(seekingPhaseMusic);
-            }
-            if (victorySound.frameCount > 0) {
-                PlaySound(victorySound);
-            }
-        } else if (gameTimer <= 0) {
-            playerWon = false;
-            lastGameTime = 0;
-            currentScreen = GameScreen::GAME_OVER;
-            if (seekingPhaseMusic.stream.buffer != NULL) {
-                StopMusicStream(seekingPhaseMusic);
-            }
-            if (gameOverSound.frameCount > 0) {
-                PlaySound(gameOverSound);
-            }
-        } else if (playerGotTagged) {
-            playerWon = false;
-            lastGameTime = SEEKING_PHASE_DURATION - gameTimer;
-            currentScreen = GameScreen::GAME_OVER;
-            if (seekingPhaseMusic.stream.buffer != NULL) {
-                StopMusicStream(seekingPhaseMusic);
-            }
-            if (gameOverSound.frameCount > 0) {
-                PlaySound(gameOverSound);
-            }
-        }
+void GameManager::SaveReplay() {
+    replay.Finish((int)sim.result);
+    if (!DirectoryExists(REPLAY_DIRECTORY)) {
+        MakeDirectory(REPLAY_DIRECTORY);
+    }
+    const char* path = TextFormat("%s/%016llx.hsreplay", REPLAY_DIRECTORY, (unsigned long long)sim.matchSeed);
+    if (!replay.Save(path)) {
+        TraceLog(LOG_WARNING, "REPLAY: Could not save %s", path);
     }
 }
 
@@ -398,6 +518,9 @@ void GameManager::Draw() {
     ClearBackground(BLACK); 
 
     switch (currentScreen) {
+        case GameScreen::LOADING:
+            uiManager.DrawLoadingScreen(assetLoader.GetProgress((int)AssetGroupFor(screenAfterLoading)));
+            break;
         case GameScreen::MAIN_MENU:
             uiManager.DrawMainMenu(currentScreen, this->quitGame, this->restartGameFlag);
             break;
@@ -412,12 +535,17 @@ void GameManager::Draw() {
             uiManager.DrawPauseMenu(currentScreen, this->quitGame, this->restartGameFlag);
             break;
         case GameScreen::GAME_OVER:
-            uiManager.DrawGameOverScreen(currentScreen, playerWon, lastGameTime, this->restartGameFlag);
+            uiManager.DrawGameOverScreen(currentScreen, sim.PlayerWon(), sim.lastGameTime, this->restartGameFlag);
             break;
         default:
             break;
     } 
     //DrawFPS(SCREEN_WIDTH - 90, 10);
+#ifdef HIDENSEEK_PROFILE
+    if (showProfiler) {
+        Profiler::DrawOverlay(SCREEN_WIDTH - 370, 10);
+    }
+#endif
     EndDrawing();
 }
 
@@ -425,11 +553,11 @@ void GameManager::Draw() {
 
 void GameManager::DrawInGame() {
     // --- HIDING PHASE VISUALS ("Countdown" screen) ---
-    if (currentPhase == GamePhase::HIDING && hidingPhaseElapsed < 10.0f) {
+    if (sim.currentPhase == GamePhase::HIDING && sim.hidingPhaseElapsed < 10.0f) {
         ClearBackground(BLACK); // Start with a black screen
 
         float time = GetTime(); 
-        float displayTimeRemaining = 10.0f - hidingPhaseElapsed;
+        float displayTimeRemaining = 10.0f - sim.hidingPhaseElapsed;
 
         // Define Stages for Messages
         float stage1Duration = 4.0f; 
@@ -443,36 +571,37 @@ void GameManager::DrawInGame() {
         Font messageFont = (uiManager.titleTextFont.texture.id != 0) ? uiManager.titleTextFont : GetFontDefault();
         Font timerDetailFont = (uiManager.bodyTextFont.texture.id != 0) ? uiManager.bodyTextFont : GetFontDefault();
 
-        if (hidingPhaseElapsed < stage1Duration) {
+        if (sim.hidingPhaseElapsed < stage1Duration) {
             msg = "CLOSE YOUR EYES!";
             msgColor = GetColor(0xAF3800FF);
             msgFontSize = 80;
             float pulseSpeed = 3.0f;
             msgPulseScale = 1.0f + 0.05f * sinf(time * pulseSpeed); 
-        } else if (hidingPhaseElapsed < (10.0f - stage3Duration)) {
+        } else if (sim.hidingPhaseElapsed < (10.0f - stage3Duration)) {
             msg = "Hiders are hiding...";
             msgColor = GetColor(0xEDEAD0FF);
             msgFontSize = 60;
-        } else if (hidingPhaseElapsed < 10.0f) {
+        } else if (sim.hidingPhaseElapsed < 10.0f) {
             msg = "GET READY!";
             msgColor = GetColor(0xFFCF56FF);
             msgFontSize = 90;
             float pulseSpeed = 6.0f;
             msgPulseScale = 1.0f + 0.1f * fabsf(sinf(time * pulseSpeed)); 
 
-            if (hidingPhaseElapsed >= (10.0f - stage3Duration) && 
-                hidingPhaseElapsed < (10.0f - stage3Duration + 0.1f)) { 
+            if (sim.hidingPhaseElapsed >= (10.0f - stage3Duration) && 
+                sim.hidingPhaseElapsed < (10.0f - stage3Duration + 0.1f)) { 
                 DrawRectangle(0,0,SCREEN_WIDTH, SCREEN_HEIGHT, Fade(WHITE, 0.3f));
             }
         }
 
         // Draw the main message
         if (msg) { 
-            float actualMsgFontSize = msgFontSize * msgPulseScale;
-            Vector2 textSize = MeasureTextEx(messageFont, msg, actualMsgFontSize, 1);
-            DrawTextEx(messageFont, msg, 
+            // Laid out once at the base size and scaled for the pulse, rather than remeasured every frame
+            const TextRun& msgRun = uiManager.text.Get(messageFont, msg, (float)msgFontSize);
+            Vector2 textSize = Vector2Scale(msgRun.size, msgPulseScale);
+            TextCache::Draw(msgRun, 
                        {(SCREEN_WIDTH - textSize.x) / 2, SCREEN_HEIGHT * 0.4f - textSize.y / 2}, 
-                       actualMsgFontSize, 1, msgColor);
+                       msgColor, msgPulseScale);
         }
 
         // Draw Timer
@@ -490,60 +619,61 @@ void GameManager::DrawInGame() {
              if (displayTimeRemaining <= 1.5f) timerColor = GetColor(0xAF3800FF);
         }
         
-        float actualTimerFontSize = timerFontSize * timerPulseScale;
-        Vector2 timerTextSize = MeasureTextEx(timerDetailFont, timerText, actualTimerFontSize, 1); 
-        DrawTextEx(timerDetailFont, timerText, 
+        const TextRun& timerRun = uiManager.text.Get(timerDetailFont, timerText, (float)timerFontSize);
+        Vector2 timerTextSize = Vector2Scale(timerRun.size, timerPulseScale); 
+        TextCache::Draw(timerRun, 
                    {(SCREEN_WIDTH - timerTextSize.x) / 2, SCREEN_HEIGHT * 0.6f - timerTextSize.y / 2}, 
-                   actualTimerFontSize, 1, timerColor);
+                   timerColor, timerPulseScale);
     } else {
         // Draw game elements with camera
         BeginMode2D(camera);
             // Draw base map and walls first
-            gameMap.DrawBaseAndWalls();
+            sim.gameMap.DrawBaseAndWalls();
             
             // Draw hiders before the object texture so they appear behind hiding spots
-            for (auto& hider : hiders) {
-                if (!hider.isTagged) {
-                    hider.Draw();
-                }
-            }
+            characterSprites.Begin(characterAtlas);
+            sim.hiders.Draw(renderAlpha, characterSprites); // Skips tagged hiders
             
             // Draw object texture (hiding spots) on top of hiders, with transparency based on player position
-            gameMap.DrawObjects(player.position);
+            sim.gameMap.DrawObjects(sim.player.GetRenderPosition(renderAlpha));
             
             // Draw player last so it's always on top
-            player.Draw();
+            sim.player.Draw(renderAlpha, characterSprites);
         EndMode2D();
         
         // Draw the black overlay with vision cone
-        Vector2 screenPos = GetWorldToScreen2D(player.position, camera);
-        float radius = PLAYER_VISION_RADIUS * camera.zoom;
-        float coneAngle = 60.0f; // Angle of the vision cone in degrees
-
-        // Create the vision overlay
-        BeginTextureMode(visionOverlay);
-            ClearBackground(BLACK);  // Start with black background
+        {
+            PROFILE_SCOPE("Vision overlay");
+            Vector2 screenPos = GetWorldToScreen2D(camera.target, camera);
+            float radius = PLAYER_VISION_RADIUS * camera.zoom;
+            float coneAngle = 60.0f; // Angle of the vision cone in degrees
+
+            // Create the vision overlay
+            BeginTextureMode(visionOverlay);
+                ClearBackground(BLACK);  // Start with black background
             
-            // Draw the dark overlay
-            DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, ColorAlpha(BLACK, 0.95f));
+                // Draw the dark overlay
+                DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, ColorAlpha(BLACK, 0.95f));
             
-            // Cut out the vision circle using BLEND_SUBTRACT_COLORS
-            BeginBlendMode(BLEND_SUBTRACT_COLORS);
-                DrawCircleV(screenPos, radius - 200, WHITE);  // Use WHITE to cut out the circle
+                // Cut out the vision circle using BLEND_SUBTRACT_COLORS
+                BeginBlendMode(BLEND_SUBTRACT_COLORS);
+                    DrawCircleV(screenPos, radius - 200, WHITE);  // Use WHITE to cut out the circle
+                EndBlendMode();
+            EndTextureMode();
+
+            // Draw the final overlay
+            BeginBlendMode(BLEND_ALPHA);
+                DrawTextureRec(
+                    visionOverlay.texture,
+                    (Rectangle){ 0, 0, (float)SCREEN_WIDTH, -(float)SCREEN_HEIGHT },  // Flip Y
+                    (Vector2){ 0, 0 },
+                    WHITE
+                );
             EndBlendMode();
-        EndTextureMode();
-
-        // Draw the final overlay
-        BeginBlendMode(BLEND_ALPHA);
-            DrawTextureRec(
-                visionOverlay.texture,
-                (Rectangle){ 0, 0, (float)SCREEN_WIDTH, -(float)SCREEN_HEIGHT },  // Flip Y
-                (Vector2){ 0, 0 },
-                WHITE
-            );
-        EndBlendMode();
+        }
 
         // Draw UI elements in screen space
-        uiManager.DrawInGameHUD(gameTimer, hidersRemaining, player.sprintValue);
+        PROFILE_SCOPE("HUD");
+        uiManager.DrawInGameHUD(sim.gameTimer, sim.hidersRemaining, sim.player.sprintValue);
     }
 }
\ No newline at end of file
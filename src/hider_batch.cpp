@@ -0,0 +1,744 @@
+#include "hider_batch.h"
+#include "player.h"
+#include "map.h"
+#include "flee_field.h"
+#include "spatial_hash.h"
+#include "thread_pool.h"
+#include "sprite_atlas.h"
+#include "sim_clock.h" // For LerpAngle
+#include "profiler.h"
+#include "raymath.h"
+#include <cmath>     // For atan2f, fabsf
+#include <cstdio>    // For snprintf
+#include <algorithm> // For std::copy
+
+void HiderState::Allocate(SimArena& arena, int count) {
+    arena.Allocate(position, count);
+    arena.Allocate(rotation, count);
+    arena.Allocate(isTagged, count);
+    arena.Allocate(hidingState, count);
+    arena.Allocate(seekingState, count);
+    arena.Allocate(targetHidingSpot, count);
+}
+
+void HiderState::Reset() {
+    position.Fill({0, 0});
+    rotation.Fill(0.0f);
+    isTagged.Fill(0);
+    hidingState.Fill(HiderHidingFSMState::SCOUTING);
+    seekingState.Fill(HiderSeekingFSMState::IDLING);
+    targetHidingSpot.Fill({0, 0});
+}
+
+void HiderState::CopyFrom(const HiderState& other) {
+    std::copy(other.position.begin(), other.position.end(), position.begin());
+    std::copy(other.rotation.begin(), other.rotation.end(), rotation.begin());
+    std::copy(other.isTagged.begin(), other.isTagged.end(), isTagged.begin());
+    std::copy(other.hidingState.begin(), other.hidingState.end(), hidingState.begin());
+    std::copy(other.seekingState.begin(), other.seekingState.end(), seekingState.begin());
+    std::copy(other.targetHidingSpot.begin(), other.targetHidingSpot.end(), targetHidingSpot.begin());
+}
+
+HiderBatch::HiderBatch() : threadPool(nullptr) {
+    for (int skin = 0; skin < HIDER_SKIN_COUNT; ++skin) {
+        standSkins[skin] = -1;
+        attackSkins[skin] = -1;
+    }
+}
+
+void HiderBatch::LayoutArrays() {
+    buffers[0].Allocate(arena, count);
+    buffers[1].Allocate(arena, count);
+    arena.Allocate(speed, count);
+    arena.Allocate(timeSinceLastTag, count);
+    arena.Allocate(timeSinceLastPlayerMovement, count);
+    arena.Allocate(lastPlayerPosition, count);
+    arena.Allocate(attackCooldownTimer, count);
+    arena.Allocate(randomMovementTimer, count);
+    arena.Allocate(randomMovementDirection, count);
+    arena.Allocate(idleAlertTimer, count);
+    arena.Allocate(evadeAlertTimer, count);
+    arena.Allocate(random, count);
+    arena.Allocate(claimedSpot, count);
+    arena.Allocate(taggedPlayer, count);
+    arena.Allocate(pathPoints, (size_t)count * HIDER_MAX_PATH_POINTS);
+    arena.Allocate(pathLength, count);
+    arena.Allocate(pathIndex, count);
+    arena.Allocate(pathGoalCell, count);
+    arena.Allocate(tagsLanded, count);
+    arena.Allocate(taggedAt, count);
+}
+
+void HiderBatch::Resize(int hiderCount, uint64_t seed) {
+    if (hiderCount != count || arena.Size() == 0) {
+        count = hiderCount;
+        arena.BeginLayout();
+        LayoutArrays();
+        arena.CommitLayout();
+        LayoutArrays();
+    }
+    matchSeed = seed;
+    buffers[0].Reset();
+    buffers[1].Reset();
+    frontBuffer = 0;
+    // The arena starts zeroed but is reused between matches, so everything is reset here
+    speed.Fill(HIDER_SPEED);
+    timeSinceLastTag.Fill(0.0f);
+    timeSinceLastPlayerMovement.Fill(0.0f);
+    lastPlayerPosition.Fill({0, 0});
+    attackCooldownTimer.Fill(0.0f);
+    randomMovementTimer.Fill(0.0f);
+    randomMovementDirection.Fill({0, 0});
+    idleAlertTimer.Fill(0.0f);
+    evadeAlertTimer.Fill(0.0f);
+    random.Fill(RandomStream());
+    claimedSpot.Fill(0);
+    taggedPlayer.Fill(0);
+    pathPoints.Fill({0, 0});
+    pathLength.Fill(0);
+    pathIndex.Fill(0);
+    pathGoalCell.Fill(-1);
+    tagsLanded.Fill(0);
+    taggedAt.Fill(-1.0f);
+    tagEvents = 0;
+    simTime = 0.0f;
+    for (auto& group : stateGroups) group.reserve(count);
+}
+
+void HiderBatch::Spawn(int i, Vector2 startPos) {
+    random[i] = RandomStream(matchSeed, RANDOM_STREAM_HIDER_BASE + (uint64_t)i);
+    float startRotation = (float)random[i].NextInt(360); // Random initial rotation
+    for (HiderState& s : buffers) { // Both, so the first frames don't interpolate from stale state
+        s.position[i] = startPos;
+        s.rotation[i] = startRotation;
+        s.isTagged[i] = 0;
+        s.hidingState[i] = HiderHidingFSMState::SCOUTING;
+        s.seekingState[i] = HiderSeekingFSMState::IDLING;
+    }
+    attackCooldownTimer[i] = 0.0f;
+    randomMovementTimer[i] = 0.0f;
+    randomMovementDirection[i] = {0, 0};
+    idleAlertTimer[i] = 0.0f;
+    evadeAlertTimer[i] = 0.0f;
+    pathLength[i] = 0;
+    pathIndex[i] = 0;
+    pathGoalCell[i] = -1;
+}
+
+#ifndef HIDENSEEK_HEADLESS
+void HiderBatch::LoadSkins(SpriteAtlas& atlas) {
+    char standTextureName[32];
+    char tagTextureName[32];
+
+    for (int skin = 0; skin < HIDER_SKIN_COUNT; ++skin) {
+        if (skin == 0) {
+            snprintf(standTextureName, sizeof(standTextureName), "hider_stand.png");
+            snprintf(tagTextureName, sizeof(tagTextureName), "hider_tag.png");
+        } else {
+            snprintf(standTextureName, sizeof(standTextureName), "hider%d_stand.png", skin);
+            snprintf(tagTextureName, sizeof(tagTextureName), "hider%d_tag.png", skin);
+        }
+
+        standSkins[skin] = atlas.AddFile(standTextureName);
+        attackSkins[skin] = atlas.AddFile(tagTextureName);
+    }
+}
+#endif
+
+Vector2 HiderBatch::GetForwardVector(const HiderState& s, int i) {
+    return Vector2Rotate({1, 0}, s.rotation[i] * DEG2RAD);
+}
+
+bool HiderBatch::IsInVision(const HiderState& s, int i, Vector2 targetPos) {
+    Vector2 toTarget = Vector2Subtract(targetPos, s.position[i]);
+    float distanceToTarget = Vector2Length(toTarget);
+
+    if (distanceToTarget > HIDER_VISION_RADIUS || distanceToTarget < 0.1f) {
+        return false;
+    }
+
+    Vector2 forward = GetForwardVector(s, i);
+    if (Vector2LengthSqr(forward) == 0) return false;
+
+    Vector2 normalizedToTarget = Vector2Normalize(toTarget);
+    float dotProduct = Vector2DotProduct(forward, normalizedToTarget);
+    float angleToTargetRad = acosf(dotProduct);
+    float angleToTargetDeg = angleToTargetRad * RAD2DEG;
+
+    return angleToTargetDeg <= HIDER_VISION_CONE_ANGLE / 2.0f;
+}
+
+int HiderBatch::CountRemaining() const {
+    int remaining = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!Front().isTagged[i]) remaining++;
+    }
+    return remaining;
+}
+
+template <typename State>
+void HiderBatch::BuildStateGroups(ArraySpan<State> states) {
+    const HiderState& s = Front();
+    for (auto& group : stateGroups) group.clear();
+    for (int i = 0; i < count; ++i) {
+        if (!s.isTagged[i]) stateGroups[(int)states[i]].push_back(i);
+    }
+}
+
+template <typename Body>
+void HiderBatch::ForEachInGroup(int group, Body body) {
+    const std::vector<int>& members = stateGroups[group];
+    if (!threadPool) {
+        for (int i : members) body(i);
+        return;
+    }
+    threadPool->ParallelFor((int)members.size(), HIDER_UPDATE_MIN_CHUNK, [&](int begin, int end) {
+        PROFILE_SCOPE("Hider chunk");
+        for (int k = begin; k < end; ++k) body(members[k]);
+    });
+}
+
+void HiderBatch::Update(float deltaTime, GamePhase currentPhase, Player& player, const Map& gameMap, SpatialHash& hiderHash, const FleeField& fleeField) {
+    tagEvents = 0;
+    simTime += deltaTime;
+
+    // Work on a copy of the last tick; Front() stays untouched until the swap
+    Back().CopyFrom(Front());
+
+    if (currentPhase == GamePhase::HIDING) {
+        UpdateHidingPhase(deltaTime, gameMap, player, hiderHash);
+    } else if (currentPhase == GamePhase::SEEKING) {
+        UpdateSeekingPhase(deltaTime, player, gameMap, fleeField);
+    }
+
+    const HiderState& s = Back();
+    for (int i = 0; i < count; ++i) {
+        if (!s.isTagged[i] && attackCooldownTimer[i] > 0) {
+            attackCooldownTimer[i] -= deltaTime;
+        }
+    }
+
+    frontBuffer = 1 - frontBuffer;
+}
+
+// --- HIDING PHASE FSM ---
+void HiderBatch::UpdateHidingPhase(float deltaTime, const Map& gameMap, const Player& player, SpatialHash& hiderHash) {
+    BuildStateGroups(Front().hidingState);
+    HiderState& s = Back();
+
+    {
+        PROFILE_SCOPE("Hiders: scouting");
+        ForEachInGroup((int)HiderHidingFSMState::SCOUTING, [&](int i) {
+            Scout(s, i, deltaTime, gameMap, player, hiderHash);
+        });
+    }
+    {
+        PROFILE_SCOPE("Hiders: moving to spot");
+        ForEachInGroup((int)HiderHidingFSMState::MOVING_TO_HIDING_SPOT, [&](int i) {
+            MoveToHidingSpot(s, i, deltaTime, gameMap);
+        });
+    }
+    // HIDING: stay still, maybe slight animation if you add one
+
+    PROFILE_SCOPE("Hiders: claims");
+    ResolveClaims(hiderHash);
+}
+
+void HiderBatch::ResolveClaims(SpatialHash& hiderHash) {
+    // Scouts only saw last tick's claims, so two of them may have picked spots close together.
+    // Going in hider order, the lower index keeps its spot and the other scouts again next tick.
+    HiderState& s = Back();
+    for (int i : stateGroups[(int)HiderHidingFSMState::SCOUTING]) {
+        if (!claimedSpot[i]) continue;
+        claimedSpot[i] = 0;
+        if (hiderHash.AnyInRadius(s.targetHidingSpot[i], HIDER_RADIUS * 15, i)) {
+            s.hidingState[i] = HiderHidingFSMState::SCOUTING;
+            continue;
+        }
+        AddToSpatialHash(s, i, hiderHash);
+    }
+}
+
+bool HiderBatch::IsSpotTaken(int i, Vector2 spot, const SpatialHash& hiderHash, const Player& player) {
+    // Increase minimum distance between hiders significantly
+    float minDistance = HIDER_RADIUS * 15; // Increased from 10 to 15
+
+    // Check distance from player with increased safety margin
+    if (Vector2DistanceSqr(spot, player.position) < (PLAYER_RADIUS + HIDER_RADIUS + 100) * (PLAYER_RADIUS + HIDER_RADIUS + 100)) {
+        return true;
+    }
+
+    // Check other hiders' positions, claimed spots and projected paths (see AddToSpatialHash)
+    return hiderHash.AnyInRadius(spot, minDistance, i);
+}
+
+void HiderBatch::AddToSpatialHash(const HiderState& s, int i, SpatialHash& hiderHash) {
+    hiderHash.Insert(i, s.position[i]);
+    if (s.hidingState[i] == HiderHidingFSMState::SCOUTING) return;
+
+    // Claimed spot, so no other hider heads for it
+    hiderHash.Insert(i, s.targetHidingSpot[i]);
+
+    // Where a moving hider will be shortly
+    if (s.hidingState[i] == HiderHidingFSMState::MOVING_TO_HIDING_SPOT) {
+        Vector2 direction = Vector2Normalize(Vector2Subtract(s.targetHidingSpot[i], s.position[i]));
+        hiderHash.Insert(i, Vector2Add(s.position[i], Vector2Scale(direction, HIDER_RADIUS * 10)));
+    }
+}
+
+void HiderBatch::Scout(HiderState& s, int i, float deltaTime, const Map& gameMap, const Player& player, const SpatialHash& hiderHash) {
+    // Try to find an unoccupied hiding spot
+    for (const auto& spot : gameMap.GetHidingSpots()) {
+        // First check if the spot is valid (not in an obstacle)
+        if (!gameMap.IsPositionValid(spot, HIDER_RADIUS)) {
+            continue; // Skip invalid spots
+        }
+
+        // If this spot is free and valid, take it
+        if (!IsSpotTaken(i, spot, hiderHash, player)) {
+            s.targetHidingSpot[i] = spot;
+            s.hidingState[i] = HiderHidingFSMState::MOVING_TO_HIDING_SPOT;
+            pathGoalCell[i] = -1; // Plan a fresh path to the new spot
+            claimedSpot[i] = 1; // Checked against this tick's other claims in ResolveClaims
+
+            // Update rotation to face target
+            Vector2 direction = Vector2Normalize(Vector2Subtract(spot, s.position[i]));
+            if (Vector2LengthSqr(direction) > 0) {
+                s.rotation[i] = atan2f(direction.y, direction.x) * RAD2DEG;
+            }
+            return;
+        }
+    }
+
+    // If no valid spots are found, move randomly in open space
+    const float randomMovementInterval = 1.0f; // Change direction every second
+
+    // Update random movement timer
+    randomMovementTimer[i] += deltaTime;
+
+    // Change direction periodically or if we hit an obstacle
+    if (randomMovementTimer[i] >= randomMovementInterval || Vector2LengthSqr(randomMovementDirection[i]) == 0) {
+        randomMovementTimer[i] = 0.0f;
+        float randomAngle = (float)random[i].NextInt(360) * DEG2RAD;
+        randomMovementDirection[i] = Vector2Rotate({1, 0}, randomAngle);
+        s.rotation[i] = randomAngle * RAD2DEG;
+    }
+
+    // Move in the current random direction
+    Vector2 newPos = Vector2Add(s.position[i], Vector2Scale(randomMovementDirection[i], speed[i] * 0.5f * deltaTime));
+
+    if (gameMap.IsPositionValid(newPos, HIDER_RADIUS)) {
+        s.position[i] = newPos;
+    } else {
+        // If we hit an obstacle, immediately change direction
+        randomMovementTimer[i] = randomMovementInterval; // Force direction change on next frame
+        randomMovementDirection[i] = {0, 0}; // Force new direction calculation
+    }
+}
+
+void HiderBatch::MoveToHidingSpot(HiderState& s, int i, float deltaTime, const Map& gameMap) {
+    // Follow the cached path to the spot claimed in Scout
+    if (!FollowPath(s, i, s.targetHidingSpot[i], speed[i] * 1.2f * deltaTime, gameMap)) {
+        // If we can't find a path to the spot, go back to scouting
+        s.hidingState[i] = HiderHidingFSMState::SCOUTING;
+        return;
+    }
+
+    // If we're close enough to the spot, start hiding
+    if (Vector2Distance(s.position[i], s.targetHidingSpot[i]) < HIDER_RADIUS * 2) {
+        s.position[i] = s.targetHidingSpot[i]; // Snap to spot
+        s.hidingState[i] = HiderHidingFSMState::HIDING;
+    }
+}
+
+bool HiderBatch::FollowPath(HiderState& s, int i, Vector2 goal, float stepDistance, const Map& gameMap) {
+    const Pathfinder& pathfinder = gameMap.GetPathfinder();
+    Vector2* path = &pathPoints[(size_t)i * HIDER_MAX_PATH_POINTS];
+    thread_local std::vector<Vector2> pathScratch; // One per worker, reused between searches
+    int goalCell = pathfinder.CellIndex(goal);
+    if (goalCell != pathGoalCell[i]) {
+        pathGoalCell[i] = goalCell;
+        pathIndex[i] = 0;
+        pathLength[i] = 0;
+        if (!pathfinder.FindPath(s.position[i], goal, pathScratch)) {
+            pathGoalCell[i] = -1; // Try again next time
+            return false;
+        }
+        // Longer paths are cut short; the last slot steers at the goal and replans if a wall is in the way
+        pathLength[i] = (int)pathScratch.size() < HIDER_MAX_PATH_POINTS ? (int)pathScratch.size() : HIDER_MAX_PATH_POINTS;
+        for (int p = 0; p < pathLength[i]; ++p) {
+            path[p] = pathScratch[p];
+        }
+    }
+
+    // Skip waypoints we are already standing on (a replan can start on a path corner)
+    while (pathIndex[i] + 1 < pathLength[i] && Vector2DistanceSqr(path[pathIndex[i]], s.position[i]) < 0.000001f) {
+        pathIndex[i]++;
+    }
+
+    // The last leg steers at the live goal, so a goal moving inside its cell is still reached
+    Vector2 waypoint = (pathIndex[i] + 1 >= pathLength[i]) ? goal : path[pathIndex[i]];
+    Vector2 toWaypoint = Vector2Subtract(waypoint, s.position[i]);
+    float distance = Vector2Length(toWaypoint);
+    if (distance < 0.001f) return true; // Already there
+
+    Vector2 direction = Vector2Scale(toWaypoint, 1.0f / distance);
+    bool reachesWaypoint = distance <= stepDistance;
+    Vector2 newPos = reachesWaypoint ? waypoint : Vector2Add(s.position[i], Vector2Scale(direction, stepDistance));
+
+    // One collision query per step; if something is in the way, drop the path so it gets replanned
+    if (!gameMap.IsPositionValid(newPos, HIDER_RADIUS)) {
+        pathGoalCell[i] = -1;
+        return false;
+    }
+
+    s.position[i] = newPos;
+    s.rotation[i] = atan2f(direction.y, direction.x) * RAD2DEG;
+    if (reachesWaypoint && pathIndex[i] + 1 < pathLength[i]) {
+        pathIndex[i]++;
+    }
+    return true;
+}
+
+
+// --- SEEKING PHASE FSM ---
+void HiderBatch::UpdateSeekingPhase(float deltaTime, Player& player, const Map& gameMap, const FleeField& fleeField) {
+    HiderState& s = Back();
+    for (int i = 0; i < count; ++i) {
+        if (s.isTagged[i]) continue;
+        timeSinceLastTag[i] += deltaTime;
+
+        if (Vector2Distance(player.position, lastPlayerPosition[i]) < 1.0f) {
+            timeSinceLastPlayerMovement[i] += deltaTime;
+        } else {
+            timeSinceLastPlayerMovement[i] = 0.0f;
+            lastPlayerPosition[i] = player.position;
+        }
+    }
+
+    // Group by the state at the start of the tick, so a hider that changes state is not updated twice
+    BuildStateGroups(Front().seekingState);
+
+    {
+        PROFILE_SCOPE("Hiders: idling");
+        ForEachInGroup((int)HiderSeekingFSMState::IDLING, [&](int i) {
+            Idle(s, i, deltaTime, player, gameMap);
+            if (CanAttack(s, i, player)) {
+                s.seekingState[i] = HiderSeekingFSMState::ATTACKING;
+            }
+        });
+    }
+    {
+        PROFILE_SCOPE("Hiders: evading");
+        ForEachInGroup((int)HiderSeekingFSMState::EVADING, [&](int i) {
+            Evade(s, i, deltaTime, player, gameMap, fleeField);
+        });
+    }
+    {
+        PROFILE_SCOPE("Hiders: attacking");
+        ForEachInGroup((int)HiderSeekingFSMState::ATTACKING, [&](int i) {
+            AttemptTag(s, i, deltaTime, gameMap, player);
+        });
+    }
+
+    // The player is shared, so tags are applied here rather than by the hiders themselves
+    for (int i : stateGroups[(int)HiderSeekingFSMState::ATTACKING]) {
+        if (!taggedPlayer[i]) continue;
+        taggedPlayer[i] = 0;
+        player.SetTagged(true);
+        tagsLanded[i]++;
+        tagEvents++;
+    }
+}
+
+void HiderBatch::Idle(HiderState& s, int i, float deltaTime, const Player& player, const Map& gameMap) {
+    // Check for direct collision first
+    float distanceToPlayer = Vector2Distance(s.position[i], player.position);
+    float collisionDistance = HIDER_RADIUS + PLAYER_RADIUS;
+    if (distanceToPlayer <= collisionDistance) {
+        s.seekingState[i] = HiderSeekingFSMState::EVADING;
+        return;
+    }
+
+    // Check if we're at a hiding spot
+    bool isAtHidingSpot = false;
+    Vector2 currentSpot = {0, 0};
+    for (const auto& spot : gameMap.GetHidingSpots()) {
+        if (Vector2Distance(s.position[i], spot) < HIDER_RADIUS * 2) {
+            isAtHidingSpot = true;
+            currentSpot = spot;
+            break;
+        }
+    }
+
+    // Check for very close proximity to player (0.1f)
+    if (distanceToPlayer <= 0.1f) {
+        s.seekingState[i] = HiderSeekingFSMState::EVADING;
+        return;
+    }
+
+    // If we're at a hiding spot
+    if (isAtHidingSpot) {
+        // Check if player is inside our current hiding spot
+        float distanceToSpot = Vector2Distance(player.position, currentSpot);
+        if (distanceToSpot < HIDER_RADIUS * 2) {
+            // Run to the nearest other hiding spot that is on our side of the player
+            Vector2 fleeSpot = {0, 0};
+            bool foundFleeSpot = false;
+            float bestDistance = 0.0f;
+            for (const auto& spot : gameMap.GetHidingSpots()) {
+                float distance = Vector2Distance(s.position[i], spot);
+                if (distance < HIDER_RADIUS * 2) continue; // Skip our current spot
+                if (Vector2Distance(player.position, spot) <= distance) continue; // Player is closer to it
+                if (!foundFleeSpot || distance < bestDistance) {
+                    fleeSpot = spot;
+                    bestDistance = distance;
+                    foundFleeSpot = true;
+                }
+            }
+
+            if (!foundFleeSpot || !FollowPath(s, i, fleeSpot, speed[i] * 1.2f * deltaTime, gameMap)) {
+                // If we can't get away, switch to evading
+                s.seekingState[i] = HiderSeekingFSMState::EVADING;
+            }
+            return;
+        }
+        // Stay still at hiding spot if player is not inside it
+        return;
+    }
+
+    // If not at a hiding spot, use normal idle behavior
+    bool playerInVision = IsInVision(s, i, player.position);
+
+    // Check if player is in vision or too close
+    if (playerInVision || distanceToPlayer < HIDER_VISION_RADIUS) {
+        // Check if player is looking at us
+        if (player.IsLookingAt(s.position[i])) {
+            s.seekingState[i] = HiderSeekingFSMState::EVADING;
+            return;
+        }
+
+        // If player is in vision but not looking at us, check for alert status
+        if (player.IsInAlertStatus()) {
+            idleAlertTimer[i] += deltaTime;
+
+            if (idleAlertTimer[i] >= 1.5f) {
+                s.seekingState[i] = HiderSeekingFSMState::ATTACKING;
+                idleAlertTimer[i] = 0.0f;
+                return;
+            }
+        } else {
+            // Reset timer if player is not in alert status
+            idleAlertTimer[i] = 0.0f;
+        }
+
+        // If player is in vision but not looking at us, move around
+        if (distanceToPlayer < HIDER_VISION_RADIUS) {
+            // Move around the player in a circular pattern
+            Vector2 toPlayer = Vector2Subtract(player.position, s.position[i]);
+            float angleToPlayer = atan2f(toPlayer.y, toPlayer.x) * RAD2DEG;
+
+            // Calculate a perpendicular direction to circle around the player
+            float circleAngle = angleToPlayer + 90.0f; // 90 degrees perpendicular
+            Vector2 circleDirection = Vector2Rotate({1, 0}, circleAngle * DEG2RAD);
+
+            // Move in the circular pattern
+            Vector2 newPos = Vector2Add(s.position[i], Vector2Scale(circleDirection, speed[i] * 0.7f * deltaTime));
+
+            if (gameMap.IsPositionValid(newPos, HIDER_RADIUS)) {
+                s.position[i] = newPos;
+                s.rotation[i] = circleAngle; // Face the direction of movement
+            } else {
+                // If we hit an obstacle, try the opposite direction
+                circleAngle = angleToPlayer - 90.0f;
+                circleDirection = Vector2Rotate({1, 0}, circleAngle * DEG2RAD);
+                newPos = Vector2Add(s.position[i], Vector2Scale(circleDirection, speed[i] * 0.7f * deltaTime));
+
+                if (gameMap.IsPositionValid(newPos, HIDER_RADIUS)) {
+                    s.position[i] = newPos;
+                    s.rotation[i] = circleAngle;
+                } else {
+                    // If both directions are blocked, go back to evading
+                    s.seekingState[i] = HiderSeekingFSMState::EVADING;
+                }
+            }
+        } else {
+            // If player is in vision but too far, start evading
+            s.seekingState[i] = HiderSeekingFSMState::EVADING;
+        }
+    }
+    // When player is not in vision and far away, stay still but keep checking
+}
+
+void HiderBatch::Evade(HiderState& s, int i, float deltaTime, const Player& player, const Map& gameMap, const FleeField& fleeField) {
+    // Check if player is in alert status
+    if (player.IsInAlertStatus()) {
+        evadeAlertTimer[i] += deltaTime;
+
+        if (evadeAlertTimer[i] >= 1.5f) {
+            s.seekingState[i] = HiderSeekingFSMState::ATTACKING;
+            evadeAlertTimer[i] = 0.0f;
+            return;
+        }
+    } else {
+        // Reset timer if player is not in alert status
+        evadeAlertTimer[i] = 0.0f;
+    }
+
+    // Check if we're stuck: if stepping straight away from the nearest wall is blocked, nothing else will work
+    Vector2 escapePos = Vector2Add(s.position[i], Vector2Scale(gameMap.GetGradient(s.position[i]), speed[i] * deltaTime));
+    bool isStuck = !gameMap.IsPositionValid(escapePos, HIDER_RADIUS);
+
+    // If we're stuck, switch to attacking immediately
+    if (isStuck) {
+        s.seekingState[i] = HiderSeekingFSMState::ATTACKING;
+        return;
+    }
+
+    // Each hider has a unique evasion pattern based on their ID
+    float evasionAngle = 0.0f;
+    float evasionSpeed = speed[i];
+
+    // Use the hider index to create unique behavior patterns
+    switch (i % 4) {
+        case 0: // Zigzag pattern
+            evasionAngle = (float)((int)(simTime * 2) % 2) * 45.0f - 22.5f;
+            evasionSpeed = speed[i] * 1.2f;
+            break;
+        case 1: // Circular pattern
+            evasionAngle = simTime * 90.0f;
+            evasionSpeed = speed[i] * 0.9f;
+            break;
+        case 2: // Sharp turns
+            evasionAngle = (float)((int)(simTime * 3) % 2) * 90.0f - 45.0f;
+            evasionSpeed = speed[i] * 1.1f;
+            break;
+        case 3: // Erratic movement
+            evasionAngle = (float)random[i].NextInt(360);
+            evasionSpeed = speed[i] * (0.8f + (float)random[i].NextInt(40) / 100.0f);
+            break;
+    }
+
+    // Read the shared flee field; off the field (or at a local minimum) just head away from the player
+    Vector2 fleeDirection = fleeField.GetDirection(gameMap.GetPathfinder(), s.position[i]);
+    if (Vector2LengthSqr(fleeDirection) == 0) {
+        fleeDirection = Vector2Normalize(Vector2Subtract(s.position[i], player.position));
+    }
+
+    // Steer off walls we're getting close to
+    float clearance = gameMap.GetClearance(s.position[i]);
+    float wallAvoidDistance = HIDER_RADIUS * 3;
+    if (clearance < wallAvoidDistance) {
+        float push = 1.0f - clearance / wallAvoidDistance;
+        fleeDirection = Vector2Normalize(Vector2Add(fleeDirection, Vector2Scale(gameMap.GetGradient(s.position[i]), push)));
+    }
+
+    // Apply the unique evasion pattern as a bounded wobble (max 45 degrees) around the field direction
+    float wobbleAngle = 45.0f * sinf(evasionAngle * DEG2RAD);
+    Vector2 evasionDirection = Vector2Rotate(fleeDirection, wobbleAngle * DEG2RAD);
+
+    // Add some randomness to prevent synchronized movement
+    float randomVariation = (float)(random[i].NextInt(20) - 10) / 100.0f;
+    evasionDirection = Vector2Rotate(evasionDirection, randomVariation * DEG2RAD);
+
+    // Try to move in the calculated direction
+    Vector2 newPos = Vector2Add(s.position[i], Vector2Scale(evasionDirection, evasionSpeed * deltaTime));
+
+    // If the wobble runs into a wall, follow the field itself, sliding along the wall if needed
+    if (!gameMap.IsPositionValid(newPos, HIDER_RADIUS)) {
+        evasionDirection = fleeDirection;
+        Vector2 step = Vector2Scale(evasionDirection, evasionSpeed * deltaTime);
+        newPos = Vector2Add(s.position[i], step);
+
+        if (!gameMap.IsPositionValid(newPos, HIDER_RADIUS)) {
+            // Drop the part of the step that goes into the wall
+            Vector2 wallNormal = gameMap.GetGradient(s.position[i]);
+            float intoWall = Vector2DotProduct(step, wallNormal);
+            newPos = Vector2Add(s.position[i], Vector2Subtract(step, Vector2Scale(wallNormal, intoWall < 0 ? intoWall : 0.0f)));
+
+            if (!gameMap.IsPositionValid(newPos, HIDER_RADIUS)) {
+                // Near obstacle corners, fall back to moving one axis at a time
+                newPos = {s.position[i].x + step.x, s.position[i].y};
+                if (!gameMap.IsPositionValid(newPos, HIDER_RADIUS)) {
+                    newPos = {s.position[i].x, s.position[i].y + step.y};
+                    if (!gameMap.IsPositionValid(newPos, HIDER_RADIUS)) {
+                        // If still stuck, switch to attacking
+                        s.seekingState[i] = HiderSeekingFSMState::ATTACKING;
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+    // Update position and rotation
+    s.position[i] = newPos;
+    s.rotation[i] = atan2f(evasionDirection.y, evasionDirection.x) * RAD2DEG;
+
+    // Check if we should return to idle state
+    float distanceToPlayer = Vector2Distance(s.position[i], player.position);
+    if (distanceToPlayer > HIDER_VISION_RADIUS * 1.5f) {
+        s.seekingState[i] = HiderSeekingFSMState::IDLING;
+    }
+}
+
+#ifndef HIDENSEEK_HEADLESS
+void HiderBatch::Draw(float alpha, SpriteBatch& sprites) const {
+    PROFILE_SCOPE("Hiders draw");
+    const HiderState& s = Front();
+    const HiderState& previous = buffers[1 - frontBuffer];
+
+    // Sprites first, all from the atlas, then the shapes, so each kind goes out as one batch
+    for (int i = 0; i < count; ++i) {
+        if (s.isTagged[i]) continue;
+        int skin = i % HIDER_SKIN_COUNT;
+        int frame = standSkins[skin];
+        if (s.seekingState[i] == HiderSeekingFSMState::ATTACKING && attackSkins[skin] >= 0) {
+            frame = attackSkins[skin];
+        }
+        if (frame < 0) continue;
+        Vector2 drawPosition = Vector2Lerp(previous.position[i], s.position[i], alpha);
+        float drawRotation = LerpAngle(previous.rotation[i], s.rotation[i], alpha);
+        sprites.Add(frame, drawPosition, drawRotation, HIDER_RADIUS * 2);
+    }
+    sprites.End();
+
+    for (int i = 0; i < count; ++i) {
+        if (s.isTagged[i]) continue;
+        Vector2 drawPosition = Vector2Lerp(previous.position[i], s.position[i], alpha);
+        float drawRotation = LerpAngle(previous.rotation[i], s.rotation[i], alpha);
+        if (standSkins[i % HIDER_SKIN_COUNT] < 0) {
+            DrawCircleV(drawPosition, HIDER_RADIUS, BLUE);
+        }
+
+        // Draw vision cone for debugging
+        Vector2 forward = Vector2Rotate({1, 0}, drawRotation * DEG2RAD);
+        DrawLineV(drawPosition, Vector2Add(drawPosition, Vector2Scale(forward, HIDER_RADIUS)), BLACK);
+    }
+}
+#endif
+
+bool HiderBatch::CanAttack(const HiderState& s, int i, const Player& player) const {
+    return (!player.IsLookingAt(s.position[i]) &&
+            timeSinceLastPlayerMovement[i] > 2.0f &&
+            timeSinceLastTag[i] > 5.0f &&
+            attackCooldownTimer[i] <= 0.0f &&
+            Vector2Distance(s.position[i], player.position) < HIDER_VISION_RADIUS);
+}
+
+void HiderBatch::AttemptTag(HiderState& s, int i, float deltaTime, const Map& gameMap, const Player& player) {
+    float distanceToPlayer = Vector2Distance(s.position[i], player.position);
+    float collisionDistance = HIDER_RADIUS + PLAYER_RADIUS;
+
+    // Chase the player along a path, replanned only when the player changes nav cell
+    FollowPath(s, i, player.position, speed[i] * 1.2f * deltaTime, gameMap);
+
+    // Check for successful tag
+    if (distanceToPlayer <= collisionDistance) {
+        // Tag successful; applied to the player after the pass, and the game manager plays the tag sound
+        taggedPlayer[i] = 1;
+        timeSinceLastTag[i] = 0.0f;
+        attackCooldownTimer[i] = attackCooldown;
+        s.seekingState[i] = HiderSeekingFSMState::IDLING;
+    }
+}
@@ -0,0 +1,29 @@
+#include "keyboard_seeker_controller.h"
+#include "raylib.h"
+
+KeyboardSeekerController::KeyboardSeekerController() : skipHidingRequested(false), tagRequested(false) {
+}
+
+void KeyboardSeekerController::Reset() {
+    skipHidingRequested = false;
+    tagRequested = false;
+}
+
+void KeyboardSeekerController::Poll() {
+    if (IsKeyPressed(KEY_SPACE)) skipHidingRequested = true;
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || IsKeyPressed(KEY_ENTER)) tagRequested = true;
+}
+
+SeekerInput KeyboardSeekerController::NextInput(const Simulation&) {
+    uint8_t flags = 0;
+    if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP)) flags |= SEEKER_INPUT_UP;
+    if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN)) flags |= SEEKER_INPUT_DOWN;
+    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT)) flags |= SEEKER_INPUT_LEFT;
+    if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) flags |= SEEKER_INPUT_RIGHT;
+    if (IsKeyDown(KEY_LEFT_SHIFT)) flags |= SEEKER_INPUT_SPRINT;
+    if (tagRequested) flags |= SEEKER_INPUT_TAG;
+    if (skipHidingRequested) flags |= SEEKER_INPUT_SKIP_HIDING;
+    tagRequested = false;
+    skipHidingRequested = false;
+    return SeekerInput(flags);
+}
@@ -2,9 +2,32 @@
 #include "resource_dir.h" // From template
 #include "constants.h"
 #include "game_manager.h"
+#include "profiler.h"
 #include <iostream> // For debugging
+#include <cstdlib>  // For strtof, atoi
+#include <cstring>  // For strcmp
+#include <string>
+
+int main(int argc, char** argv) {
+    // hidenseek [--replay <file.hsreplay> [--speed <x>]] watches a saved match instead of playing
+    // --asset-budget <MiB> and --prefetch <0|1> tune screen asset loading for low-memory machines
+    std::string replayPath;
+    float replaySpeed = 1.0f;
+    float assetBudgetMiB = -1.0f;
+    int prefetch = -1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--replay") == 0) replayPath = argv[i + 1];
+        else if (strcmp(argv[i], "--speed") == 0) replaySpeed = strtof(argv[i + 1], nullptr);
+        else if (strcmp(argv[i], "--asset-budget") == 0) assetBudgetMiB = strtof(argv[i + 1], nullptr);
+        else if (strcmp(argv[i], "--prefetch") == 0) prefetch = atoi(argv[i + 1]);
+    }
+    // Relative to where the game was started, since the resource directory becomes the working directory below
+    bool absolute = !replayPath.empty() && (replayPath[0] == '/' || replayPath[0] == '\\' ||
+                                             (replayPath.size() > 1 && replayPath[1] == ':'));
+    if (!replayPath.empty() && !absolute) {
+        replayPath = std::string(GetWorkingDirectory()) + "/" + replayPath;
+    }
 
-int main() {
     SetConfigFlags(FLAG_VSYNC_HINT | FLAG_WINDOW_HIGHDPI | FLAG_MSAA_4X_HINT);
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, GAME_TITLE);
     SetTargetFPS(60);
@@ -21,11 +44,19 @@ int main() {
     }
 
     GameManager gameManager;
-    gameManager.InitGame(); // Initialize game state, load assets, etc.
+    if (assetBudgetMiB >= 0.0f) gameManager.assetBudget = (size_t)(assetBudgetMiB * 1024 * 1024);
+    if (prefetch >= 0) gameManager.prefetchAssets = prefetch != 0;
+    if (replayPath.empty() || !gameManager.StartReplay(replayPath.c_str(), replaySpeed)) {
+        gameManager.InitGame(); // Initialize game state, load assets, etc.
+    }
 
     while (!WindowShouldClose() && !gameManager.quitGame) {
-        gameManager.Update();
-        gameManager.Draw();
+        {
+            PROFILE_SCOPE("Frame");
+            gameManager.Update();
+            gameManager.Draw();
+        }
+        PROFILE_FRAME();
     }
 
     CloseAudioDevice(); // Close audio device before closing window
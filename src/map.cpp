@@ -1,170 +1,182 @@
 #include "map.h"
 #include "constants.h"
-#include "raymath.h" // For Vector2Distance
-#include <cstdlib> // For rand()
 
 Map::Map() {
+    width = SCREEN_WIDTH;
+    height = SCREEN_HEIGHT;
     background = {0}; // Initialize texture struct
     // TODO: Add Texture2D wallTexture = {0}; to your Map class in map.h
     wallTexture = {0}; // Initialize the new texture struct
     objTexture = {0};
     interior = {0};
+    staticLayerColumns = 0;
+    showObstacles = false;
+    layoutHash = 0;
 }
 
 void Map::Load() {
-    // Load the base map design
-    if (FileExists("map_design.jpg")) {
-        background = LoadTexture("map_design.jpg");
-    } 
-    if (FileExists("map_interior.png")) {
-        interior = LoadTexture("map_interior.png");
+    // Use the baked map file if there is one, otherwise bake the built-in layout now
+    if (!LoadLayout(MAP_FILE_PATH)) {
+        BuildDefaultLayout();
     }
+}
 
-    // Load the wall texture
-    if (FileExists("wall_bg.png")) {
-        wallTexture = LoadTexture("wall_bg.png");
+bool Map::LoadLayout(const char* path) {
+    if (!mapFile.Open(path)) return false;
+    const MapFileHeader& header = *mapFile.header;
+
+    width = header.worldWidth;
+    height = header.worldHeight;
+    obstacles = mapFile.GetSection<Rectangle>(header.obstacles);
+    hidingSpots = mapFile.GetSection<Vector2>(header.hidingSpots);
+    spawnPoints = mapFile.GetSection<Vector2>(header.spawnPoints);
+    obstacleStorage.clear();
+    hidingSpotStorage.clear();
+    spawnPointStorage.clear();
+
+    // Grids baked with different collision settings are stale; rebake those from the file's obstacles
+    if (header.collisionSafetyMargin == COLLISION_SAFETY_MARGIN) {
+        collisionGrids.clear();
+        collisionGrids.reserve(header.collisionGrids.count);
+        for (const auto& grid : mapFile.GetSection<MapFileCollisionGrid>(header.collisionGrids)) {
+            collisionGrids.emplace_back();
+            collisionGrids.back().Attach(grid.radius, grid.width, grid.height, mapFile.GetSection<uint64_t>(grid.bits));
+        }
+    } else {
+        BakeCollisionGrids();
     }
 
-    if (FileExists("Object_hiding.png")) {
-        objTexture = LoadTexture("Object_hiding.png");
+    if (header.sdfCellSize == SDF_CELL_SIZE && header.sdfDistance.count > 0) {
+        distanceField.Attach(header.sdfCellSize, header.sdfCols, header.sdfRows,
+                             mapFile.GetSection<float>(header.sdfDistance), mapFile.GetSection<Vector2>(header.sdfGradient));
+    } else {
+        distanceField.Bake(obstacles, width, height, SDF_CELL_SIZE);
     }
-    // Horizontal wall above kitchen
-    obstacles.push_back({236, 242, 394, 146});
-    obstacles.push_back({551, 169, 80, 74});
-    obstacles.push_back({630, 316, 78, 73});
-    // Top wall
-    obstacles.push_back({552, 21, 393, 74});
-    obstacles.push_back({867, 95, 77, 74});
-    // Reverse L Wall Top
-    obstacles.push_back({787, 317, 158, 73});
-    obstacles.push_back({866, 244, 79, 73});
-    // Hallway Boxes
-    obstacles.push_back({866, 462, 80, 73});
-    obstacles.push_back({563, 472, 49, 48});
-    // Bottom wall
-    obstacles.push_back({236, 533, 80, 75});
-    obstacles.push_back({236, 608, 708, 74});
-    InitHidingSpots();
-}
 
-void Map::InitHidingSpots() {
-    hidingSpots.clear();
-    
-    if (IsPositionValid(HIDING_SPOT_BUSH_G1, 0)) hidingSpots.push_back(HIDING_SPOT_BUSH_G1);
-    if (IsPositionValid(HIDING_SPOT_BUSH_G2, 0)) hidingSpots.push_back(HIDING_SPOT_BUSH_G2);
-    if (IsPositionValid(HIDING_SPOT_BUSH_G3, 0)) hidingSpots.push_back(HIDING_SPOT_BUSH_G3);
-    if (IsPositionValid(HIDING_SPOT_BUSH_G4, 0)) hidingSpots.push_back(HIDING_SPOT_BUSH_G4);
-    if (IsPositionValid(HIDING_SPOT_BUSH_G5, 0)) hidingSpots.push_back(HIDING_SPOT_BUSH_G5);
-    if (IsPositionValid(HIDING_SPOT_BUSH_B1, 0)) hidingSpots.push_back(HIDING_SPOT_BUSH_B1);
-    if (IsPositionValid(HIDING_SPOT_BUSH_B2, 0)) hidingSpots.push_back(HIDING_SPOT_BUSH_B2);
-    if (IsPositionValid(HIDING_SPOT_BUSH_B3, 0)) hidingSpots.push_back(HIDING_SPOT_BUSH_B3);
-    if (IsPositionValid(HIDING_SPOT_BUSH_B4, 0)) hidingSpots.push_back(HIDING_SPOT_BUSH_B4);
-    if (IsPositionValid(HIDING_SPOT_TABLE_1, 0)) hidingSpots.push_back(HIDING_SPOT_TABLE_1);
-    if (IsPositionValid(HIDING_SPOT_TABLE_2, 0)) hidingSpots.push_back(HIDING_SPOT_TABLE_2);
-    if (IsPositionValid(HIDING_SPOT_WASHER, 0)) hidingSpots.push_back(HIDING_SPOT_WASHER);
-    if (IsPositionValid(HIDING_SPOT_BOX, 0)) hidingSpots.push_back(HIDING_SPOT_BOX);
-    if (IsPositionValid(HIDING_SPOT_COUCH_1, 0)) hidingSpots.push_back(HIDING_SPOT_COUCH_1);
-    if (IsPositionValid(HIDING_SPOT_COUCH_2, 0)) hidingSpots.push_back(HIDING_SPOT_COUCH_2);
-    if (IsPositionValid(HIDING_SPOT_COUCH_3, 0)) hidingSpots.push_back(HIDING_SPOT_COUCH_3);
-    if (IsPositionValid(HIDING_SPOT_PLANT, 0)) hidingSpots.push_back(HIDING_SPOT_PLANT);
+    if (header.navCellSize == NAV_CELL_SIZE && header.navWalkable.count > 0 &&
+        header.collisionSafetyMargin == COLLISION_SAFETY_MARGIN) {
+        pathfinder.Attach(*this, header.navCellSize, header.navCols, header.navRows, mapFile.GetSection<uint8_t>(header.navWalkable));
+    } else {
+        pathfinder.Build(*this);
+    }
+    ComputeLayoutHash();
+    return true;
 }
 
-Vector2 Map::GetRandomHidingSpot() const {
-    if (hidingSpots.empty()) {
-        // Fallback if no spots defined, though InitHidingSpots should prevent this
-        return {(float)(rand() % SCREEN_WIDTH), (float)(rand() % SCREEN_HEIGHT)};
+void Map::BuildLayout(int worldWidth, int worldHeight, const std::vector<Rectangle>& layoutObstacles,
+                      const std::vector<Vector2>& layoutHidingSpots, const std::vector<Vector2>& layoutSpawnPoints) {
+    mapFile.Close();
+    width = worldWidth;
+    height = worldHeight;
+    obstacleStorage = layoutObstacles;
+    obstacles = obstacleStorage;
+    BakeCollisionGrids();
+    distanceField.Bake(obstacles, width, height, SDF_CELL_SIZE);
+    pathfinder.Build(*this);
+
+    // Drop hiding spots and spawns that ended up inside an obstacle
+    hidingSpotStorage.clear();
+    for (const auto& spot : layoutHidingSpots) {
+        if (IsPositionValid(spot, 0)) hidingSpotStorage.push_back(spot);
     }
-    return hidingSpots[rand() % hidingSpots.size()];
-}
+    hidingSpots = hidingSpotStorage;
 
-void Map::Unload() {
-    if (background.id > 0) UnloadTexture(background);
-    // TODO: Unload wallTexture if it was loaded
-    if (wallTexture.id > 0) UnloadTexture(wallTexture);
-    if (objTexture.id > 0) UnloadTexture(objTexture);
+    spawnPointStorage.clear();
+    for (const auto& spawn : layoutSpawnPoints) {
+        if (IsPositionValid(spawn, PLAYER_RADIUS)) spawnPointStorage.push_back(spawn);
+    }
+    spawnPoints = spawnPointStorage;
+
+    ComputeLayoutHash();
 }
 
-void Map::Draw() {
-    // Draw the base map design first
-    if (background.id > 0) {
-        DrawTexture(background, 0, 0, WHITE);
-    } else {
-        ClearBackground(RAYWHITE); // Fallback if no texture
-    }
-    if (interior.id > 0) {
-        DrawTexture(interior, 0, 0, WHITE);
-    }
-    if (wallTexture.id > 0) {
-        DrawTexture(wallTexture, 0, 0, WHITE);
-    }
+// Over the layout and the settings the grids are baked with, which is all the simulation
+// sees of a map; a baked file and the same layout built in memory hash the same
+void Map::ComputeLayoutHash() {
+    const float collisionSafetyMargin = COLLISION_SAFETY_MARGIN;
+    const int navCellSize = NAV_CELL_SIZE;
+    const float sdfCellSize = SDF_CELL_SIZE;
+    layoutHash = HashMapBytes(&width, sizeof(width));
+    layoutHash = HashMapBytes(&height, sizeof(height), layoutHash);
+    layoutHash = HashMapBytes(obstacles.data, obstacles.size() * sizeof(Rectangle), layoutHash);
+    layoutHash = HashMapBytes(hidingSpots.data, hidingSpots.size() * sizeof(Vector2), layoutHash);
+    layoutHash = HashMapBytes(spawnPoints.data, spawnPoints.size() * sizeof(Vector2), layoutHash);
+    layoutHash = HashMapBytes(&collisionSafetyMargin, sizeof(collisionSafetyMargin), layoutHash);
+    layoutHash = HashMapBytes(&navCellSize, sizeof(navCellSize), layoutHash);
+    layoutHash = HashMapBytes(&sdfCellSize, sizeof(sdfCellSize), layoutHash);
+}
 
-    // Draw obstacles (for debugging or if they are simple visual elements)
-    for (const auto& obs : obstacles) {
-        DrawRectangleRec(obs, Fade(BLACK, 0.0f));
-    }
+void Map::BuildDefaultLayout() {
+    std::vector<Rectangle> layoutObstacles = {
+        // Horizontal wall above kitchen
+        {236, 242, 394, 146},
+        {551, 169, 80, 74},
+        {630, 316, 78, 73},
+        // Top wall
+        {552, 21, 393, 74},
+        {867, 95, 77, 74},
+        // Reverse L Wall Top
+        {787, 317, 158, 73},
+        {866, 244, 79, 73},
+        // Hallway Boxes
+        {866, 462, 80, 73},
+        {563, 472, 49, 48},
+        // Bottom wall
+        {236, 533, 80, 75},
+        {236, 608, 708, 74},
+    };
+
+    std::vector<Vector2> layoutHidingSpots = {
+        HIDING_SPOT_BUSH_G1, HIDING_SPOT_BUSH_G2, HIDING_SPOT_BUSH_G3, HIDING_SPOT_BUSH_G4, HIDING_SPOT_BUSH_G5,
+        HIDING_SPOT_BUSH_B1, HIDING_SPOT_BUSH_B2, HIDING_SPOT_BUSH_B3, HIDING_SPOT_BUSH_B4,
+        HIDING_SPOT_TABLE_1, HIDING_SPOT_TABLE_2, HIDING_SPOT_WASHER, HIDING_SPOT_BOX,
+        HIDING_SPOT_COUCH_1, HIDING_SPOT_COUCH_2, HIDING_SPOT_COUCH_3, HIDING_SPOT_PLANT,
+    };
+
+    // Player spawns in the corners, padded away from the edges
+    float padding = PLAYER_RADIUS + 50.0f;
+    std::vector<Vector2> layoutSpawnPoints = {
+        {padding, padding},                                      // Top-left
+        {SCREEN_WIDTH - padding, padding},                     // Top-right
+        {padding, SCREEN_HEIGHT - padding},                    // Bottom-left
+        {SCREEN_WIDTH - padding, SCREEN_HEIGHT - padding}      // Bottom-right
+    };
+
+    BuildLayout(SCREEN_WIDTH, SCREEN_HEIGHT, layoutObstacles, layoutHidingSpots, layoutSpawnPoints);
 }
 
-void Map::DrawBaseAndWalls() {
-    // Draw the base map design first
-    if (background.id > 0) {
-        DrawTexture(background, 0, 0, WHITE);
-    } else {
-        ClearBackground(RAYWHITE); // Fallback if no texture
-    }
-    if (interior.id > 0) {
-        DrawTexture(interior, 0, 0, WHITE);
-    }
-    // Draw the wall texture on top
-    if (wallTexture.id > 0) {
-        DrawTexture(wallTexture, 0, 0, WHITE);
+void Map::BakeCollisionGrids() {
+    // One grid per entity radius that queries the map: hiding spot checks, hiders and the player
+    const float radii[] = {0.0f, HIDER_RADIUS, PLAYER_RADIUS};
+    collisionGrids.clear();
+    collisionGrids.reserve(sizeof(radii) / sizeof(radii[0]));
+    for (float radius : radii) {
+        collisionGrids.emplace_back();
+        collisionGrids.back().Bake(obstacles, radius, width, height);
     }
+}
 
-    // Draw obstacles (for debugging or if they are simple visual elements)
-    for (const auto& obs : obstacles) {
-        DrawRectangleRec(obs, Fade(BLACK, 0.0f));
+const CollisionGrid* Map::FindCollisionGrid(float radius) const {
+    for (const auto& grid : collisionGrids) {
+        if (grid.radius == radius) return &grid;
     }
+    return nullptr;
 }
 
-void Map::DrawObjects(const Vector2& playerPos) {
-    // Draw the object texture (hiding spots)
-    if (objTexture.id > 0) {
-        // Define the transparency range
-        float maxDistance = 50.0f;  // Maximum distance for partial transparency
-        float minDistance = 10.0f;  // Minimum distance for maximum transparency
-        
-        // Find the closest hiding spot to the player
-        float closestDistance = maxDistance;
-        for (const auto& spot : hidingSpots) {
-            float distance = Vector2Distance(playerPos, spot);
-            if (distance < closestDistance) {
-                closestDistance = distance;
-            }
-        }
-        
-        // Calculate alpha based on closest distance
-        float alpha = 1.0f;
-        if (closestDistance < maxDistance) {
-            if (closestDistance < minDistance) {
-                alpha = 0.3f; // Partially transparent when very close
-            } else {
-                // Linear interpolation between 0.3 and 1.0
-                alpha = 0.3f + (0.7f * (closestDistance - minDistance) / (maxDistance - minDistance));
-            }
-        }
-        
-        // Draw with transparency
-        BeginBlendMode(BLEND_ALPHA);
-            DrawTexture(objTexture, 0, 0, ColorAlpha(WHITE, alpha));
-        EndBlendMode();
+Vector2 Map::GetRandomHidingSpot(RandomStream& random) const {
+    if (hidingSpots.empty()) {
+        // Fallback if no spots defined, though InitHidingSpots should prevent this
+        return {(float)random.NextInt(width), (float)random.NextInt(height)};
     }
+    return hidingSpots[random.NextInt((int)hidingSpots.size())];
 }
 
 bool Map::IsPositionValid(Vector2 position, float radius) const {
     // Check screen boundaries without margin
     float minX = 0;
-    float maxX = SCREEN_WIDTH;
+    float maxX = (float)width;
     float minY = 0;
-    float maxY = SCREEN_HEIGHT;
+    float maxY = (float)height;
 
     // Check if position is within bounds, accounting for the entity's radius
     if (position.x - radius < minX || position.x + radius > maxX ||
@@ -172,10 +184,16 @@ bool Map::IsPositionValid(Vector2 position, float radius) const {
         return false;
     }
 
+    // Use the baked grid for this radius if there is one
+    const CollisionGrid* grid = FindCollisionGrid(radius);
+    if (grid) {
+        return !grid->IsBlocked(position);
+    }
+
     // Check against all obstacles with a safety margin
     for (const auto& obs : obstacles) {
         // Create a slightly larger rectangle to account for the radius and safety margin
-        float safetyMargin = radius + 5.0f; // Add 5 pixels of safety margin
+        float safetyMargin = radius + COLLISION_SAFETY_MARGIN;
         Rectangle expandedObs = {
             obs.x - safetyMargin,
             obs.y - safetyMargin,
@@ -183,11 +201,11 @@ bool Map::IsPositionValid(Vector2 position, float radius) const {
             obs.height + (safetyMargin * 2)
         };
         
-        // Check if the position is inside the expanded obstacle
-        if (CheckCollisionPointRec(position, expandedObs)) {
+        // Check if the position is inside the expanded obstacle (same test as CheckCollisionPointRec)
+        if (position.x >= expandedObs.x && position.x < expandedObs.x + expandedObs.width &&
+            position.y >= expandedObs.y && position.y < expandedObs.y + expandedObs.height) {
             return false;
         }
     }
     return true;
 }
-
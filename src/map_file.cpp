@@ -0,0 +1,142 @@
+#include "map_file.h"
+#include "map.h"
+#include "constants.h"
+#include <cmath>   // For ceilf
+#include <cstdio>  // For fopen, fwrite
+#include <cstring> // For memcpy
+#include <vector>
+
+namespace {
+
+// Appends count elements at the next aligned offset and returns where they landed
+MapFileSection AppendSection(std::vector<unsigned char>& buffer, const void* data, size_t count, size_t elementSize) {
+    size_t offset = (buffer.size() + MAP_FILE_ALIGNMENT - 1) / MAP_FILE_ALIGNMENT * MAP_FILE_ALIGNMENT;
+    buffer.resize(offset + count * elementSize, 0);
+    if (count > 0) memcpy(&buffer[offset], data, count * elementSize);
+    return {offset, count};
+}
+
+} // namespace
+
+MapFile::MapFile() : header(nullptr) {
+}
+
+bool MapFile::Open(const char* path) {
+    Close();
+    if (!file.Open(path)) return false;
+
+    if (file.size < sizeof(MapFileHeader)) {
+        Close();
+        return false;
+    }
+
+    const MapFileHeader* fileHeader = (const MapFileHeader*)file.data;
+    if (fileHeader->magic != MAP_FILE_MAGIC || fileHeader->version != MAP_FILE_VERSION ||
+        fileHeader->worldWidth <= 0 || fileHeader->worldHeight <= 0) {
+        Close();
+        return false;
+    }
+
+    if (!IsSectionValid(fileHeader->obstacles, sizeof(Rectangle)) ||
+        !IsSectionValid(fileHeader->hidingSpots, sizeof(Vector2)) ||
+        !IsSectionValid(fileHeader->spawnPoints, sizeof(Vector2)) ||
+        !IsSectionValid(fileHeader->collisionGrids, sizeof(MapFileCollisionGrid)) ||
+        !IsSectionValid(fileHeader->navWalkable, sizeof(uint8_t)) ||
+        !IsSectionValid(fileHeader->sdfDistance, sizeof(float)) ||
+        !IsSectionValid(fileHeader->sdfGradient, sizeof(Vector2))) {
+        Close();
+        return false;
+    }
+
+    // Baked grids must have the shape the world size gives them and match the dimensions they
+    // claim, or the lookups would read past them. Dimensions are checked before they are
+    // multiplied, since two negative ones would give a plausible cell count.
+    header = fileHeader;
+    for (const auto& grid : GetSection<MapFileCollisionGrid>(header->collisionGrids)) {
+        if (grid.width != header->worldWidth || grid.height != header->worldHeight ||
+            !IsSectionValid(grid.bits, sizeof(uint64_t)) || grid.wordsPerRow != (grid.width + 63) / 64 ||
+            grid.bits.count != (uint64_t)grid.wordsPerRow * grid.height) {
+            Close();
+            return false;
+        }
+    }
+    if (header->navCols < 0 || header->navRows < 0 || header->sdfCols < 0 || header->sdfRows < 0) {
+        Close();
+        return false;
+    }
+    if (header->navWalkable.count > 0 &&
+        (header->navCellSize <= 0 || header->navCols != header->worldWidth / header->navCellSize ||
+         header->navRows != header->worldHeight / header->navCellSize || header->navCols == 0 || header->navRows == 0)) {
+        Close();
+        return false;
+    }
+    if (header->sdfDistance.count > 0 &&
+        (!(header->sdfCellSize > 0) || header->sdfCols != (int)ceilf(header->worldWidth / header->sdfCellSize) + 2 ||
+         header->sdfRows != (int)ceilf(header->worldHeight / header->sdfCellSize) + 2)) {
+        Close();
+        return false;
+    }
+    if (header->navWalkable.count != (uint64_t)header->navCols * header->navRows ||
+        header->sdfDistance.count != (uint64_t)header->sdfCols * header->sdfRows ||
+        header->sdfGradient.count != header->sdfDistance.count) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MapFile::Close() {
+    header = nullptr;
+    file.Close();
+}
+
+bool MapFile::IsSectionValid(const MapFileSection& section, size_t elementSize) const {
+    if (section.offset % MAP_FILE_ALIGNMENT != 0) return false;
+    if (section.offset > file.size) return false;
+    return section.count <= (file.size - section.offset) / elementSize;
+}
+
+bool MapFile::Write(const Map& map, const char* path) {
+    std::vector<unsigned char> buffer(sizeof(MapFileHeader), 0);
+    MapFileHeader fileHeader = {};
+    fileHeader.magic = MAP_FILE_MAGIC;
+    fileHeader.version = MAP_FILE_VERSION;
+    fileHeader.worldWidth = map.width;
+    fileHeader.worldHeight = map.height;
+
+    fileHeader.obstacles = AppendSection(buffer, map.obstacles.data, map.obstacles.size(), sizeof(Rectangle));
+    fileHeader.hidingSpots = AppendSection(buffer, map.hidingSpots.data, map.hidingSpots.size(), sizeof(Vector2));
+    fileHeader.spawnPoints = AppendSection(buffer, map.spawnPoints.data, map.spawnPoints.size(), sizeof(Vector2));
+
+    fileHeader.collisionSafetyMargin = COLLISION_SAFETY_MARGIN;
+    std::vector<MapFileCollisionGrid> grids;
+    for (const auto& grid : map.collisionGrids) {
+        MapFileCollisionGrid record = {};
+        record.radius = grid.radius;
+        record.width = grid.width;
+        record.height = grid.height;
+        record.wordsPerRow = grid.wordsPerRow;
+        record.bits = AppendSection(buffer, grid.bits.data, grid.bits.size(), sizeof(uint64_t));
+        grids.push_back(record);
+    }
+    fileHeader.collisionGrids = AppendSection(buffer, grids.data(), grids.size(), sizeof(MapFileCollisionGrid));
+
+    const Pathfinder& navGrid = map.GetPathfinder();
+    fileHeader.navCellSize = navGrid.cellSize;
+    fileHeader.navCols = navGrid.cols;
+    fileHeader.navRows = navGrid.rows;
+    fileHeader.navWalkable = AppendSection(buffer, navGrid.walkable.data, navGrid.walkable.size(), sizeof(uint8_t));
+
+    fileHeader.sdfCellSize = map.distanceField.cellSize;
+    fileHeader.sdfCols = map.distanceField.cols;
+    fileHeader.sdfRows = map.distanceField.rows;
+    fileHeader.sdfDistance = AppendSection(buffer, map.distanceField.distance.data, map.distanceField.distance.size(), sizeof(float));
+    fileHeader.sdfGradient = AppendSection(buffer, map.distanceField.gradient.data, map.distanceField.gradient.size(), sizeof(Vector2));
+
+    memcpy(&buffer[0], &fileHeader, sizeof(MapFileHeader));
+
+    FILE* out = fopen(path, "wb");
+    if (!out) return false;
+    bool written = fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size();
+    return fclose(out) == 0 && written;
+}
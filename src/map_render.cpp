@@ -0,0 +1,179 @@
+#include "map.h"
+#include "constants.h"
+#include "profiler.h"
+#include "resource_cache.h"
+#include "asset_loader.h"
+#include "raymath.h" // For Vector2Distance
+#include "rlgl.h"    // For rlSetBlendFactorsSeparate and the framebuffer calls
+#include <algorithm> // For std::min
+
+void Map::RequestTextures(AssetLoader& loader, int group) {
+    loader.Request(AssetKind::TEXTURE, "map_design.jpg", group);
+    loader.Request(AssetKind::TEXTURE, "map_interior.png", group);
+    loader.Request(AssetKind::TEXTURE, "wall_bg.png", group);
+    loader.Request(AssetKind::TEXTURE, "Object_hiding.png", group);
+}
+
+void Map::LoadTextures(ResourceCache& resources) {
+    background = resources.AcquireTexture("map_design.jpg"); // Base map design
+    interior = resources.AcquireTexture("map_interior.png");
+    wallTexture = resources.AcquireTexture("wall_bg.png");
+    objTexture = resources.AcquireTexture("Object_hiding.png");
+
+    // Only the composite is drawn from here on, so the layers themselves can go
+    BuildStaticLayer();
+    resources.ReleaseTexture(background);
+    resources.ReleaseTexture(interior);
+    resources.ReleaseTexture(wallTexture);
+    background = {0};
+    interior = {0};
+    wallTexture = {0};
+}
+
+// LoadRenderTexture without the depth buffer, which compositing in 2D never uses
+static RenderTexture2D LoadColorRenderTexture(int width, int height) {
+    RenderTexture2D target = {0};
+    target.id = rlLoadFramebuffer();
+    if (target.id == 0) return target;
+
+    rlEnableFramebuffer(target.id);
+    target.texture.id = rlLoadTexture(NULL, width, height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1);
+    target.texture.width = width;
+    target.texture.height = height;
+    target.texture.mipmaps = 1;
+    target.texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    rlFramebufferAttach(target.id, target.texture.id, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+    bool complete = rlFramebufferComplete(target.id);
+    rlDisableFramebuffer();
+
+    if (!complete) {
+        UnloadRenderTexture(target);
+        return RenderTexture2D{0};
+    }
+    return target;
+}
+
+void Map::BuildStaticLayer() {
+    UnloadStaticLayer();
+    int layerWidth = width;
+    int layerHeight = height;
+    for (const Texture2D& layer : {background, interior, wallTexture}) {
+        if (layer.id == 0) continue;
+        if (layer.width > layerWidth) layerWidth = layer.width;
+        if (layer.height > layerHeight) layerHeight = layer.height;
+    }
+    if (background.id == 0 && interior.id == 0 && wallTexture.id == 0) return;
+
+    staticLayerColumns = (layerWidth + MAP_LAYER_CHUNK_SIZE - 1) / MAP_LAYER_CHUNK_SIZE;
+    int rows = (layerHeight + MAP_LAYER_CHUNK_SIZE - 1) / MAP_LAYER_CHUNK_SIZE;
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < staticLayerColumns; ++column) {
+            int x = column * MAP_LAYER_CHUNK_SIZE;
+            int y = row * MAP_LAYER_CHUNK_SIZE;
+            RenderTexture2D chunk = LoadColorRenderTexture(std::min(MAP_LAYER_CHUNK_SIZE, layerWidth - x),
+                                                           std::min(MAP_LAYER_CHUNK_SIZE, layerHeight - y));
+            if (chunk.id == 0) {
+                UnloadStaticLayer(); // Drawn without the layer rather than with a hole in it
+                return;
+            }
+            BeginTextureMode(chunk);
+                ClearBackground(RAYWHITE); // What shows where there is no background
+                // Usual alpha blending for colour, but alpha accumulated so the chunk stays opaque
+                rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+                BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+                    if (background.id > 0) DrawTexture(background, -x, -y, WHITE);
+                    if (interior.id > 0) DrawTexture(interior, -x, -y, WHITE);
+                    if (wallTexture.id > 0) DrawTexture(wallTexture, -x, -y, WHITE);
+                EndBlendMode();
+            EndTextureMode();
+            staticLayer.push_back(chunk);
+        }
+    }
+}
+
+void Map::UnloadStaticLayer() {
+    for (const RenderTexture2D& chunk : staticLayer) {
+        UnloadRenderTexture(chunk);
+    }
+    staticLayer.clear();
+    staticLayerColumns = 0;
+}
+
+void Map::Unload(ResourceCache& resources) {
+    resources.ReleaseTexture(background);
+    resources.ReleaseTexture(interior);
+    resources.ReleaseTexture(wallTexture);
+    resources.ReleaseTexture(objTexture);
+    background = {0};
+    interior = {0};
+    wallTexture = {0};
+    objTexture = {0};
+    UnloadStaticLayer();
+}
+
+size_t Map::GetResidentBytes() const {
+    size_t bytes = 0;
+    for (const RenderTexture2D& chunk : staticLayer) {
+        bytes += (size_t)GetPixelDataSize(chunk.texture.width, chunk.texture.height, chunk.texture.format);
+    }
+    return bytes;
+}
+
+void Map::Draw() {
+    DrawBaseAndWalls();
+}
+
+void Map::DrawBaseAndWalls() {
+    PROFILE_SCOPE("Map draw");
+    if (staticLayer.empty()) {
+        ClearBackground(RAYWHITE); // Fallback if no texture
+    }
+    for (size_t i = 0; i < staticLayer.size(); ++i) {
+        const Texture2D& chunk = staticLayer[i].texture;
+        Vector2 position = {(float)((int)i % staticLayerColumns * MAP_LAYER_CHUNK_SIZE),
+                            (float)((int)i / staticLayerColumns * MAP_LAYER_CHUNK_SIZE)};
+        // Render textures are stored upside down, hence the negative height
+        DrawTextureRec(chunk, {0, 0, (float)chunk.width, -(float)chunk.height}, position, WHITE);
+    }
+
+    if (showObstacles) {
+        for (const auto& obs : obstacles) {
+            DrawRectangleLinesEx(obs, 2, RED);
+        }
+    }
+}
+
+void Map::DrawObjects(const Vector2& playerPos) {
+    PROFILE_SCOPE("Map draw");
+    // Draw the object texture (hiding spots)
+    if (objTexture.id > 0) {
+        // Define the transparency range
+        float maxDistance = 50.0f;  // Maximum distance for partial transparency
+        float minDistance = 10.0f;  // Minimum distance for maximum transparency
+        
+        // Find the closest hiding spot to the player
+        float closestDistance = maxDistance;
+        for (const auto& spot : hidingSpots) {
+            float distance = Vector2Distance(playerPos, spot);
+            if (distance < closestDistance) {
+                closestDistance = distance;
+            }
+        }
+        
+        // Calculate alpha based on closest distance
+        float alpha = 1.0f;
+        if (closestDistance < maxDistance) {
+            if (closestDistance < minDistance) {
+                alpha = 0.3f; // Partially transparent when very close
+            } else {
+                // Linear interpolation between 0.3 and 1.0
+                alpha = 0.3f + (0.7f * (closestDistance - minDistance) / (maxDistance - minDistance));
+            }
+        }
+        
+        // Draw with transparency
+        BeginBlendMode(BLEND_ALPHA);
+            DrawTexture(objTexture, 0, 0, ColorAlpha(WHITE, alpha));
+        EndBlendMode();
+    }
+}
@@ -0,0 +1,223 @@
+#include "pathfinder.h"
+#include "map.h"
+#include "constants.h"
+#include "raymath.h"
+#include <algorithm> // For std::push_heap, std::pop_heap, std::reverse
+#include <cstdlib>   // For abs
+
+namespace {
+
+const int STRAIGHT_COST = 10;
+const int DIAGONAL_COST = 14;
+
+struct OpenNode {
+    int f;
+    int cell;
+    bool operator<(const OpenNode& other) const { return f > other.f; } // Min-heap on f
+};
+
+// Per-thread search buffers, reused between searches so a replan does not allocate
+struct SearchScratch {
+    std::vector<int> gScore;
+    std::vector<int> parent;
+    std::vector<uint32_t> openStamp;   // gScore/parent are valid when openStamp == stamp
+    std::vector<uint32_t> closedStamp;
+    std::vector<OpenNode> open;
+    std::vector<int> cellPath;
+    std::vector<Vector2> points;
+    uint32_t stamp = 0;
+};
+
+thread_local SearchScratch scratch;
+
+int OctileDistance(int ax, int ay, int bx, int by) {
+    int dx = abs(ax - bx);
+    int dy = abs(ay - by);
+    return STRAIGHT_COST * (dx + dy) + (DIAGONAL_COST - 2 * STRAIGHT_COST) * std::min(dx, dy);
+}
+
+} // namespace
+
+Pathfinder::Pathfinder() : cellSize(NAV_CELL_SIZE), cols(0), rows(0), map(nullptr) {
+}
+
+void Pathfinder::Build(const Map& gameMap) {
+    map = &gameMap;
+    cellSize = NAV_CELL_SIZE;
+    cols = gameMap.width / cellSize;
+    rows = gameMap.height / cellSize;
+    storage.assign((size_t)cols * rows, 0);
+
+    for (int cy = 0; cy < rows; ++cy) {
+        for (int cx = 0; cx < cols; ++cx) {
+            storage[cy * cols + cx] = gameMap.IsPositionValid(CellCenter(cy * cols + cx), HIDER_RADIUS) ? 1 : 0;
+        }
+    }
+    walkable = storage;
+}
+
+void Pathfinder::Attach(const Map& gameMap, int gridCellSize, int gridCols, int gridRows, ArrayView<uint8_t> bakedWalkable) {
+    map = &gameMap;
+    cellSize = gridCellSize;
+    cols = gridCols;
+    rows = gridRows;
+    storage.clear();
+    walkable = bakedWalkable;
+}
+
+int Pathfinder::CellIndex(Vector2 position) const {
+    int cx = (int)(position.x / cellSize);
+    int cy = (int)(position.y / cellSize);
+    if (cx < 0) cx = 0;
+    if (cy < 0) cy = 0;
+    if (cx >= cols) cx = cols - 1;
+    if (cy >= rows) cy = rows - 1;
+    return cy * cols + cx;
+}
+
+Vector2 Pathfinder::CellCenter(int cellIndex) const {
+    return {(cellIndex % cols + 0.5f) * cellSize, (cellIndex / cols + 0.5f) * cellSize};
+}
+
+int Pathfinder::FindNearestWalkable(Vector2 position) const {
+    int cell = CellIndex(position);
+    if (walkable[cell]) return cell;
+
+    // Search a few rings around the cell, since positions hugging a wall can sit in a blocked cell
+    int cx = cell % cols;
+    int cy = cell / cols;
+    for (int ring = 1; ring <= 3; ++ring) {
+        int best = -1;
+        float bestDistance = 0.0f;
+        for (int y = cy - ring; y <= cy + ring; ++y) {
+            for (int x = cx - ring; x <= cx + ring; ++x) {
+                if (abs(x - cx) != ring && abs(y - cy) != ring) continue; // Ring border only
+                if (!IsWalkable(x, y)) continue;
+                float distance = Vector2DistanceSqr(position, CellCenter(y * cols + x));
+                if (best < 0 || distance < bestDistance) {
+                    best = y * cols + x;
+                    bestDistance = distance;
+                }
+            }
+        }
+        if (best >= 0) return best;
+    }
+    return -1;
+}
+
+bool Pathfinder::HasLineOfSight(Vector2 from, Vector2 to) const {
+    float distance = Vector2Distance(from, to);
+    int steps = (int)(distance / 4.0f) + 1; // Sample every 4 pixels
+    for (int i = 1; i <= steps; ++i) {
+        Vector2 point = Vector2Lerp(from, to, (float)i / steps);
+        if (!map->IsPositionValid(point, HIDER_RADIUS)) return false;
+    }
+    return true;
+}
+
+bool Pathfinder::FindPath(Vector2 start, Vector2 goal, std::vector<Vector2>& outPath) const {
+    outPath.clear();
+    if (!map || walkable.empty()) return false;
+
+    // Straight shot, no search needed
+    if (HasLineOfSight(start, goal)) {
+        outPath.push_back(goal);
+        return true;
+    }
+
+    int startCell = FindNearestWalkable(start);
+    int goalCell = FindNearestWalkable(goal);
+    if (startCell < 0 || goalCell < 0) return false;
+
+    size_t cellCount = walkable.size();
+    if (scratch.gScore.size() != cellCount) {
+        scratch.gScore.assign(cellCount, 0);
+        scratch.parent.assign(cellCount, -1);
+        scratch.openStamp.assign(cellCount, 0);
+        scratch.closedStamp.assign(cellCount, 0);
+        scratch.stamp = 0;
+    }
+    uint32_t stamp = ++scratch.stamp;
+    scratch.open.clear();
+
+    int goalX = goalCell % cols;
+    int goalY = goalCell / cols;
+
+    scratch.gScore[startCell] = 0;
+    scratch.parent[startCell] = -1;
+    scratch.openStamp[startCell] = stamp;
+    scratch.open.push_back({OctileDistance(startCell % cols, startCell / cols, goalX, goalY), startCell});
+
+    const int offsets[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    bool found = false;
+
+    while (!scratch.open.empty()) {
+        std::pop_heap(scratch.open.begin(), scratch.open.end());
+        int current = scratch.open.back().cell;
+        scratch.open.pop_back();
+
+        if (scratch.closedStamp[current] == stamp) continue; // Stale heap entry
+        scratch.closedStamp[current] = stamp;
+
+        if (current == goalCell) {
+            found = true;
+            break;
+        }
+
+        int cx = current % cols;
+        int cy = current / cols;
+        for (const auto& offset : offsets) {
+            int nx = cx + offset[0];
+            int ny = cy + offset[1];
+            if (!IsWalkable(nx, ny)) continue;
+
+            bool diagonal = offset[0] != 0 && offset[1] != 0;
+            // No corner cutting: both orthogonal neighbours must be open for a diagonal step
+            if (diagonal && (!IsWalkable(cx + offset[0], cy) || !IsWalkable(cx, cy + offset[1]))) continue;
+
+            int neighbor = ny * cols + nx;
+            if (scratch.closedStamp[neighbor] == stamp) continue;
+
+            int tentative = scratch.gScore[current] + (diagonal ? DIAGONAL_COST : STRAIGHT_COST);
+            if (scratch.openStamp[neighbor] == stamp && tentative >= scratch.gScore[neighbor]) continue;
+
+            scratch.openStamp[neighbor] = stamp;
+            scratch.gScore[neighbor] = tentative;
+            scratch.parent[neighbor] = current;
+            scratch.open.push_back({tentative + OctileDistance(nx, ny, goalX, goalY), neighbor});
+            std::push_heap(scratch.open.begin(), scratch.open.end());
+        }
+    }
+
+    if (!found) return false;
+
+    // Walk back from the goal cell
+    scratch.cellPath.clear();
+    for (int cell = goalCell; cell != -1; cell = scratch.parent[cell]) {
+        scratch.cellPath.push_back(cell);
+    }
+    std::reverse(scratch.cellPath.begin(), scratch.cellPath.end());
+
+    // Replace the end cells with the real start and goal, then string-pull the corners away
+    scratch.points.clear();
+    scratch.points.push_back(start);
+    if (scratch.cellPath.size() == 1) {
+        scratch.points.push_back(CellCenter(goalCell)); // Same cell but no direct line, go through its centre
+    }
+    for (size_t i = 1; i + 1 < scratch.cellPath.size(); ++i) {
+        scratch.points.push_back(CellCenter(scratch.cellPath[i]));
+    }
+    scratch.points.push_back(goal);
+
+    size_t anchor = 0;
+    size_t last = scratch.points.size() - 1;
+    while (anchor < last) {
+        size_t next = anchor + 1;
+        while (next < last && HasLineOfSight(scratch.points[anchor], scratch.points[next + 1])) {
+            next++;
+        }
+        outPath.push_back(scratch.points[next]);
+        anchor = next;
+    }
+    return true;
+}
@@ -1,60 +1,57 @@
 #include "player.h"
-#include "hider.h" // For CanTag, and alert check
+#include "hider_batch.h" // For the alert check
 #include "map.h"
-#include "game_manager.h" // Include full GameManager definition for accessing members
+#include "spatial_hash.h"
+#include "sprite_atlas.h"
 #include "raymath.h" // For Vector2Normalize, Vector2Rotate, Vector2Angle
+#include "sim_clock.h" // For LerpAngle
+#include "profiler.h"
 #include <cmath>    // For atan2f, cosf, sinf, fabsf
 
-Player::Player() : position({0, 0}), rotation(0.0f), speed(PLAYER_SPEED),
-                   sprintValue(SPRINT_MAX), isSprinting(false), showAlert(false), 
-                   texture{0}, alertTexture{0}, tagTexture{0}, gameManager(nullptr) { // Initialize textures and game manager
-    
-    if (FileExists("seeker_stand.png")) { 
-        this->texture = LoadTexture("seeker_stand.png");
-    }
-
-    // Load tag texture
-    if (FileExists("seeker_tag.png")) {
-        this->tagTexture = LoadTexture("seeker_tag.png");
-    }
+Player::Player() : standFrame(-1), tagFrame(-1), alertFrame(-1), alertSize(0.0f) {
+}
 
-    // Load tag sound
-    if (FileExists("tag.mp3")) {
-        this->tagSound = LoadSound("tag.mp3");
-        if (this->tagSound.frameCount > 0) {
-            SetSoundVolume(this->tagSound, 1.0f);
-        }
-    }
+#ifndef HIDENSEEK_HEADLESS
+void Player::LoadAssets(SpriteAtlas& atlas) {
+    standFrame = atlas.AddFile("seeker_stand.png");
+    tagFrame = atlas.AddFile("seeker_tag.png");
 
-    if (FileExists("alert_icon.png")) {
-        alertTexture = LoadTexture("alert_icon.png");
-    } else {
+    alertFrame = atlas.AddFile("alert_icon.png");
+    if (alertFrame < 0) {
         Image img = GenImageColor(20, 20, RED); // Simple red square for alert
         ImageDrawText(&img, "!", 5, 0, 20, WHITE);
-        alertTexture = LoadTextureFromImage(img);
-        UnloadImage(img);
+        alertFrame = atlas.AddImage(img);
     }
+    alertSize = atlas.GetFrame(alertFrame).width;
 }
+#endif
 
 void Player::Init(Vector2 startPos) {
     position = startPos;
     rotation = 0.0f; // Facing right
+    previousPosition = position;
+    previousRotation = rotation;
     sprintValue = SPRINT_MAX;
     isSprinting = false;
     showAlert = false;
     isTagged = false;
-    UpdateVision();
+    tagPoseTime = 0.0f;
+    UpdateVision(position, rotation);
 }
 
 Vector2 Player::GetForwardVector() const {
     return Vector2Rotate({1, 0}, rotation * DEG2RAD);
 }
 
-void Player::HandleInput(const Map& map) {
+Vector2 Player::GetRenderPosition(float alpha) const {
+    return Vector2Lerp(previousPosition, position, alpha);
+}
+
+void Player::HandleInput(float deltaTime, const SeekerInput& input, const Map& map) {
     Vector2 moveDir = {0, 0};
     
     // Handle sprint key press and release
-    if (IsKeyDown(KEY_LEFT_SHIFT)) {
+    if (input.Has(SEEKER_INPUT_SPRINT)) {
         if (sprintValue >= (SPRINT_MAX * 0.50f)) {
             isSprinting = true;
         }
@@ -64,46 +61,65 @@ void Player::HandleInput(const Map& map) {
     
     float currentSpeed = isSprinting ? PLAYER_SPRINT_SPEED : PLAYER_SPEED;
 
-    if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP)) moveDir.y -= 1;
-    if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN)) moveDir.y += 1;
-    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT)) moveDir.x -= 1;
-    if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) moveDir.x += 1;
+    if (input.Has(SEEKER_INPUT_UP)) moveDir.y -= 1;
+    if (input.Has(SEEKER_INPUT_DOWN)) moveDir.y += 1;
+    if (input.Has(SEEKER_INPUT_LEFT)) moveDir.x -= 1;
+    if (input.Has(SEEKER_INPUT_RIGHT)) moveDir.x += 1;
 
     if (Vector2LengthSqr(moveDir) > 0) {
         moveDir = Vector2Normalize(moveDir);
-        Vector2 newPos = Vector2Add(position, Vector2Scale(moveDir, currentSpeed * GetFrameTime()));
+        Vector2 newPos = Vector2Add(position, Vector2Scale(moveDir, currentSpeed * deltaTime));
 
         // Update rotation based on movement direction
         rotation = atan2f(moveDir.y, moveDir.x) * RAD2DEG;
 
         // Basic boundary collision (can be improved with map.IsPositionValid)
         if (newPos.x - PLAYER_RADIUS < 0) newPos.x = PLAYER_RADIUS;
-        if (newPos.x + PLAYER_RADIUS > SCREEN_WIDTH) newPos.x = SCREEN_WIDTH - PLAYER_RADIUS;
+        if (newPos.x + PLAYER_RADIUS > map.width) newPos.x = map.width - PLAYER_RADIUS;
         if (newPos.y - PLAYER_RADIUS < 0) newPos.y = PLAYER_RADIUS;
-        if (newPos.y + PLAYER_RADIUS > SCREEN_HEIGHT) newPos.y = SCREEN_HEIGHT - PLAYER_RADIUS;
+        if (newPos.y + PLAYER_RADIUS > map.height) newPos.y = map.height - PLAYER_RADIUS;
         
         // More robust collision check with map obstacles
         if (map.IsPositionValid(newPos, PLAYER_RADIUS)) {
              position = newPos;
         } else {
-            // Try moving only X
-            Vector2 newPosX = {newPos.x, position.y};
-            if (map.IsPositionValid(newPosX, PLAYER_RADIUS)) {
-                position = newPosX;
-            }
-            else {
-                // Try moving only Y
-                Vector2 newPosY = {position.x, newPos.y};
-                if (map.IsPositionValid(newPosY, PLAYER_RADIUS)) {
-                    position = newPosY;
+            // Slide along the wall: drop the part of the move that goes into it
+            Vector2 move = Vector2Subtract(newPos, position);
+            Vector2 wallNormal = map.GetGradient(position);
+            float intoWall = Vector2DotProduct(move, wallNormal);
+            Vector2 slidePos = Vector2Add(position, Vector2Subtract(move, Vector2Scale(wallNormal, intoWall < 0 ? intoWall : 0.0f)));
+            if (map.IsPositionValid(slidePos, PLAYER_RADIUS)) {
+                position = slidePos;
+            } else {
+                // Near obstacle corners the round distance field and the square collision margin disagree,
+                // so fall back to moving one axis at a time
+                Vector2 newPosX = {newPos.x, position.y};
+                if (map.IsPositionValid(newPosX, PLAYER_RADIUS)) {
+                    position = newPosX;
+                }
+                else {
+                    // Try moving only Y
+                    Vector2 newPosY = {position.x, newPos.y};
+                    if (map.IsPositionValid(newPosY, PLAYER_RADIUS)) {
+                        position = newPosY;
+                    }
                 }
             }
         }
     }
 }
 
-void Player::Update(float deltaTime, const Map& map, const std::vector<Hider>& hiders) {
-    HandleInput(map);
+void Player::Update(float deltaTime, const SeekerInput& input, const Map& map, const HiderBatch& hiders, const SpatialHash& hiderHash) {
+    PROFILE_SCOPE("Player update");
+    previousPosition = position;
+    previousRotation = rotation;
+    HandleInput(deltaTime, input, map);
+
+    if (input.Has(SEEKER_INPUT_TAG)) {
+        tagPoseTime = TAG_POSE_DURATION;
+    } else if (tagPoseTime > 0.0f) {
+        tagPoseTime -= deltaTime;
+    }
 
     if (isSprinting) {
         sprintValue -= SPRINT_DEPLETE_RATE * deltaTime;
@@ -112,35 +128,36 @@ void Player::Update(float deltaTime, const Map& map, const std::vector<Hider>& h
         sprintValue += SPRINT_REGEN_RATE * deltaTime;
         if (sprintValue > SPRINT_MAX) sprintValue = SPRINT_MAX;
     }
-    UpdateVision();
 
     // Alert symbol logic
     showAlert = false;
     Vector2 backDir = Vector2Rotate({-1, 0}, rotation * DEG2RAD); // Opposite to forward
-    for (const auto& hider : hiders) {
-        if (!hider.isTagged) {
-            Vector2 toHider = Vector2Subtract(hider.position, position);
+    hiderHash.Query(position, ALERT_BEHIND_DISTANCE, [&](int hiderIndex, Vector2) {
+        if (!hiders.Front().isTagged[hiderIndex]) {
+            Vector2 hiderPosition = hiders.Front().position[hiderIndex];
+            Vector2 toHider = Vector2Subtract(hiderPosition, position);
             float distToHider = Vector2Length(toHider);
             if (distToHider < ALERT_BEHIND_DISTANCE && distToHider > PLAYER_RADIUS + HIDER_RADIUS) { // Not too close (colliding)
-                if (!IsInVisionCone(hider.position, PLAYER_VISION_CONE_ANGLE, PLAYER_VISION_RADIUS)) { // Not in front vision
+                if (!IsInVisionCone(hiderPosition, PLAYER_VISION_CONE_ANGLE, PLAYER_VISION_RADIUS)) { // Not in front vision
                     // Check if hider is roughly behind
                     float angleToHider = Vector2Angle(backDir, Vector2Normalize(toHider)) * RAD2DEG;
                     if (fabsf(angleToHider) < ALERT_BEHIND_ANGLE_RANGE / 2.0f) {
                         showAlert = true;
-                        break;
+                        return true; // Stop the query
                     }
                 }
             }
         }
-    }
+        return false;
+    });
 }
 
-void Player::UpdateVision() {
+void Player::UpdateVision(Vector2 origin, float facing) {
     visionConePoints.clear();
-    visionConePoints.push_back(position); // Apex of the cone
+    visionConePoints.push_back(origin); // Apex of the cone
 
-    float startAngle = rotation - PLAYER_VISION_CONE_ANGLE / 2.0f;
-    float endAngle = rotation + PLAYER_VISION_CONE_ANGLE / 2.0f;
+    float startAngle = facing - PLAYER_VISION_CONE_ANGLE / 2.0f;
+    float endAngle = facing + PLAYER_VISION_CONE_ANGLE / 2.0f;
 
     // Add points along the arc of the vision cone for drawing
     int segments = 32; // Increased number of segments for smoother cone
@@ -159,15 +176,22 @@ void Player::UpdateVision() {
         }
         
         Vector2 pointOnRadius = {
-            position.x + radius * cosf(currentAngle * DEG2RAD),
-            position.y + radius * sinf(currentAngle * DEG2RAD)
+            origin.x + radius * cosf(currentAngle * DEG2RAD),
+            origin.y + radius * sinf(currentAngle * DEG2RAD)
         };
         visionConePoints.push_back(pointOnRadius);
     }
 }
 
 
-void Player::Draw() {
+#ifndef HIDENSEEK_HEADLESS
+void Player::Draw(float alpha, SpriteBatch& sprites) {
+    PROFILE_SCOPE("Player draw");
+    // Draw between the last two ticks, so movement stays smooth whatever the frame rate
+    Vector2 drawPosition = GetRenderPosition(alpha);
+    float drawRotation = LerpAngle(previousRotation, rotation, alpha);
+    UpdateVision(drawPosition, drawRotation);
+
     // Draw vision cone first (underneath player)
     if (visionConePoints.size() >= 3) {
         // Draw multiple layers of the cone for a gradient effect
@@ -188,29 +212,27 @@ void Player::Draw() {
     }
     
     // Draw Player
-    Texture2D currentTexture = texture;
-    if ((IsMouseButtonDown(MOUSE_LEFT_BUTTON) || IsKeyDown(KEY_ENTER)) && tagTexture.id > 0) {
-        currentTexture = tagTexture;
+    int currentFrame = standFrame;
+    if (IsTagging() && tagFrame >= 0) {
+        currentFrame = tagFrame;
     }
 
-    if (currentTexture.id > 0 && currentTexture.width > 0 && currentTexture.height > 0) {
-        Rectangle sourceRec = { 0.0f, 0.0f, (float)currentTexture.width, (float)currentTexture.height };
-        Rectangle destRec = { position.x, position.y, PLAYER_RADIUS * 2, PLAYER_RADIUS * 2 };
-        Vector2 origin = { PLAYER_RADIUS, PLAYER_RADIUS }; 
-        DrawTexturePro(currentTexture, sourceRec, destRec, origin, rotation, WHITE);
+    if (currentFrame >= 0) {
+        sprites.Add(currentFrame, drawPosition, drawRotation, PLAYER_RADIUS * 2);
     } else {
         // Fallback
-        DrawCircleV(position, PLAYER_RADIUS, PLAYER_COLOR);
-        if (currentTexture.id == 0) { TraceLog(LOG_DEBUG, "PLAYER_DRAW: Texture ID is 0, drawing placeholder.");}
+        DrawCircleV(drawPosition, PLAYER_RADIUS, PLAYER_COLOR);
     }
 
     // Draw Alert Symbol if active
     if (showAlert) {
         // Position alert icon slightly above the player
-        Vector2 alertPos = { position.x - alertTexture.width / 2.0f, position.y - PLAYER_RADIUS - alertTexture.height - 5.0f };
-        DrawTexture(alertTexture, (int)alertPos.x, (int)alertPos.y, WHITE);
+        Vector2 alertPos = { drawPosition.x, drawPosition.y - PLAYER_RADIUS - alertSize / 2.0f - 5.0f };
+        sprites.Add(alertFrame, alertPos, 0.0f, alertSize);
     }
+    sprites.End();
 }
+#endif
 
 
 bool Player::IsInVisionCone(Vector2 targetPos, float coneAngle, float visionRadius) const {
@@ -235,15 +257,13 @@ bool Player::IsInVisionCone(Vector2 targetPos, float coneAngle, float visionRadi
 
 // src/player.cpp
 
-bool Player::CanTag(const Hider& hider) const {
-    if (hider.isTagged) return false;
-
-    float distanceToHider = Vector2Distance(position, hider.position);
+bool Player::CanTag(Vector2 hiderPosition) const {
+    float distanceToHider = Vector2Distance(position, hiderPosition);
 
-    // Check if the hider's center is within the player's TAG_RANGE
-    if (distanceToHider <= TAG_RANGE) {
+    // Check if the hider's center is within the player's tag range
+    if (distanceToHider <= tagRange) {
         // Then check if the hider is within the player's vision cone
-        if (IsInVisionCone(hider.position, PLAYER_VISION_CONE_ANGLE, PLAYER_VISION_RADIUS)) {
+        if (IsInVisionCone(hiderPosition, PLAYER_VISION_CONE_ANGLE, PLAYER_VISION_RADIUS)) {
             return true;
         }
     }
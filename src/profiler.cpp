@@ -0,0 +1,194 @@
+#include "profiler.h"
+
+#ifdef HIDENSEEK_PROFILE
+
+#ifndef HIDENSEEK_HEADLESS
+#include "raylib.h"
+#endif
+#include <algorithm> // For std::sort, std::min
+#include <chrono>    // For steady_clock
+#include <cstdio>    // For fopen, fprintf
+#include <cstring>   // For memset
+#include <vector>
+
+namespace {
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+// Rings are never freed: a thread's events can still be waiting to be read after it exits
+std::atomic<ProfileRing*> rings[PROFILER_MAX_THREADS];
+std::atomic<int> ringCount(0);
+thread_local ProfileRing* threadRing = nullptr;
+thread_local bool threadDropped = false; // Past PROFILER_MAX_THREADS, this thread's events are ignored
+
+// Everything below is only touched by the main thread, in EndFrame and after it
+
+struct SystemHistory {
+    const char* name;
+    float frameMs[PROFILER_HISTORY_FRAMES]; // Summed over every thread, so a parallel pass counts its CPU time
+};
+std::vector<SystemHistory> systems;
+int historyNext = 0;  // Slot the next frame goes in
+int historyCount = 0; // Frames recorded so far, up to PROFILER_HISTORY_FRAMES
+float lastFrameMs = 0.0f;
+uint64_t lastFrameEnd = 0;
+int mainThreadId = -1;
+
+struct TraceEvent {
+    ProfileEvent event;
+    int threadId;
+};
+std::vector<TraceEvent> traceEvents; // Ring of the last PROFILER_TRACE_EVENTS events
+size_t traceNext = 0;
+
+std::vector<ProfileEvent> drained; // Reused every frame
+
+ProfileRing* RegisterThread() {
+    int id = ringCount.fetch_add(1);
+    if (id >= PROFILER_MAX_THREADS) {
+        threadDropped = true;
+        return nullptr;
+    }
+    threadRing = new ProfileRing();
+    threadRing->threadId = id;
+    rings[id].store(threadRing, std::memory_order_release);
+    return threadRing;
+}
+
+int FindSystem(const char* name) {
+    for (size_t s = 0; s < systems.size(); ++s) {
+        if (systems[s].name == name) return (int)s;
+    }
+    SystemHistory system;
+    system.name = name;
+    memset(system.frameMs, 0, sizeof(system.frameMs)); // Frames before its first event cost nothing
+    systems.push_back(system);
+    return (int)systems.size() - 1;
+}
+
+// Copies everything the writer has published since the last drain into drained
+void DrainRing(ProfileRing& ring) {
+    const uint64_t capacity = PROFILER_RING_EVENTS;
+    uint64_t write = ring.writeIndex.load(std::memory_order_acquire);
+    uint64_t read = std::max(ring.readIndex, write > capacity ? write - capacity : 0);
+    size_t first = drained.size();
+    for (uint64_t index = read; index < write; ++index) {
+        drained.push_back(ring.events[index & (capacity - 1)]);
+    }
+
+    // The writer kept going while we copied; anything it has wrapped around onto may be torn
+    uint64_t after = ring.writeIndex.load(std::memory_order_acquire);
+    if (after > read + capacity) {
+        size_t overwritten = (size_t)std::min(after - capacity - read, write - read);
+        drained.erase(drained.begin() + first, drained.begin() + first + overwritten);
+    }
+    ring.readIndex = write;
+}
+
+float Percentile(const SystemHistory& system, float fraction) {
+    float sorted[PROFILER_HISTORY_FRAMES];
+    int count = historyCount;
+    for (int f = 0; f < count; ++f) {
+        sorted[f] = system.frameMs[(historyNext - 1 - f + PROFILER_HISTORY_FRAMES) % PROFILER_HISTORY_FRAMES];
+    }
+    std::sort(sorted, sorted + count);
+    int index = std::min(count - 1, (int)(fraction * count));
+    return count > 0 ? sorted[index] : 0.0f;
+}
+
+} // namespace
+
+uint64_t Profiler::Now() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::Record(const char* name, uint64_t start, uint64_t end) {
+    ProfileRing* ring = threadRing;
+    if (!ring) {
+        if (threadDropped) return;
+        ring = RegisterThread();
+        if (!ring) return;
+    }
+    uint64_t index = ring->writeIndex.load(std::memory_order_relaxed);
+    ring->events[index & (PROFILER_RING_EVENTS - 1)] = {name, start, end};
+    ring->writeIndex.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::EndFrame() {
+    if (!threadRing && !threadDropped) RegisterThread();
+    if (threadRing) mainThreadId = threadRing->threadId;
+    if (traceEvents.empty()) traceEvents.resize(PROFILER_TRACE_EVENTS);
+
+    int slot = historyNext;
+    for (SystemHistory& system : systems) system.frameMs[slot] = 0.0f;
+
+    int threads = std::min(ringCount.load(), PROFILER_MAX_THREADS);
+    for (int t = 0; t < threads; ++t) {
+        ProfileRing* ring = rings[t].load(std::memory_order_acquire);
+        if (!ring) continue;
+        drained.clear();
+        DrainRing(*ring);
+        for (const ProfileEvent& event : drained) {
+            systems[FindSystem(event.name)].frameMs[slot] += (event.end - event.start) / 1e6f;
+            traceEvents[traceNext] = {event, ring->threadId};
+            traceNext = (traceNext + 1) % traceEvents.size();
+        }
+    }
+
+    uint64_t now = Now();
+    lastFrameMs = lastFrameEnd ? (now - lastFrameEnd) / 1e6f : 0.0f;
+    lastFrameEnd = now;
+    historyNext = (historyNext + 1) % PROFILER_HISTORY_FRAMES;
+    historyCount = std::min(historyCount + 1, PROFILER_HISTORY_FRAMES);
+}
+
+bool Profiler::WriteTrace(const char* path) {
+    FILE* out = fopen(path, "w");
+    if (!out) return false;
+
+    fprintf(out, "{\"traceEvents\":[\n");
+    int threads = std::min(ringCount.load(), PROFILER_MAX_THREADS);
+    for (int t = 0; t < threads; ++t) {
+        fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s %d\"}},\n",
+                t, t == mainThreadId ? "Main" : "Worker", t);
+    }
+    // Oldest first; slots never written have no name
+    bool first = true;
+    for (size_t k = 0; k < traceEvents.size(); ++k) {
+        const TraceEvent& trace = traceEvents[(traceNext + k) % traceEvents.size()];
+        if (!trace.event.name) continue;
+        fprintf(out, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                first ? "" : ",\n", trace.event.name, trace.threadId, trace.event.start / 1e3,
+                (trace.event.end - trace.event.start) / 1e3);
+        first = false;
+    }
+    fprintf(out, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    return fclose(out) == 0;
+}
+
+#ifndef HIDENSEEK_HEADLESS
+void Profiler::DrawOverlay(int x, int y) {
+    const int rowHeight = 14;
+    const int width = 360;
+    int height = rowHeight * (int)(systems.size() + 2) + 8;
+    DrawRectangle(x, y, width, height, Fade(BLACK, 0.75f));
+
+    DrawText(TextFormat("%d FPS  %.2f ms  (F4: save trace)", GetFPS(), lastFrameMs), x + 6, y + 4, 10, LIME);
+    // The default font isn't monospaced, so every column gets its own x
+    const int columns[3] = {x + 170, x + 230, x + 290};
+    const char* headings[3] = {"last", "p50", "p99"};
+    DrawText("ms per frame", x + 6, y + 4 + rowHeight, 10, GRAY);
+    for (int c = 0; c < 3; ++c) DrawText(headings[c], columns[c], y + 4 + rowHeight, 10, GRAY);
+
+    for (size_t s = 0; s < systems.size(); ++s) {
+        const SystemHistory& system = systems[s];
+        float values[3] = {system.frameMs[(historyNext - 1 + PROFILER_HISTORY_FRAMES) % PROFILER_HISTORY_FRAMES],
+                           Percentile(system, 0.5f), Percentile(system, 0.99f)};
+        int rowY = y + 4 + rowHeight * (int)(s + 2);
+        DrawText(system.name, x + 6, rowY, 10, WHITE);
+        for (int c = 0; c < 3; ++c) DrawText(TextFormat("%.3f", values[c]), columns[c], rowY, 10, WHITE);
+    }
+}
+#endif
+
+#endif
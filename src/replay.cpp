@@ -0,0 +1,213 @@
+#include "replay.h"
+#include "constants.h"
+#include <cmath>   // For std::isfinite
+#include <cstdio>  // For fopen, fread, fwrite, fseek, ftell
+#include <cstring> // For memcpy
+
+namespace {
+
+const uint8_t RUN_FOLLOWS_BIT = 0x80; // Set on the flags byte when a run length follows
+
+// A duration, range or cooldown read from a file
+bool IsValidSetting(float value) {
+    return std::isfinite(value) && value >= 0;
+}
+
+void WriteVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+// Returns false if the data ends in the middle of the number
+bool ReadVarint(const std::vector<uint8_t>& in, size_t& offset, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35 && offset < in.size(); shift += 7) {
+        uint8_t byte = in[offset++];
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// Decodes the run starting at offset
+bool ReadRun(const std::vector<uint8_t>& in, size_t& offset, uint8_t& flags, uint32_t& length) {
+    if (offset >= in.size()) return false;
+    uint8_t entry = in[offset++];
+    flags = entry & ~RUN_FOLLOWS_BIT;
+    length = 1;
+    uint32_t extraTicks = 0;
+    if ((entry & RUN_FOLLOWS_BIT) && ReadVarint(in, offset, extraTicks)) {
+        length += extraTicks;
+    }
+    return true;
+}
+
+} // namespace
+
+Replay::Replay() : seed(0), mapHash(0), result(0), tickCount(0), runFlags(0), runLength(0) {
+}
+
+void Replay::Begin(uint64_t matchSeed, const SimConfig& matchConfig, uint64_t matchMapHash) {
+    seed = matchSeed;
+    mapHash = matchMapHash;
+    config = matchConfig;
+    result = 0;
+    tickCount = 0;
+    inputs.clear();
+    runFlags = 0;
+    runLength = 0;
+}
+
+void Replay::Record(SeekerInput input) {
+    uint8_t flags = input.flags & ~RUN_FOLLOWS_BIT;
+    if (runLength > 0 && flags != runFlags) FlushRun();
+    runFlags = flags;
+    runLength++;
+    tickCount++;
+}
+
+void Replay::Finish(int matchResult) {
+    FlushRun();
+    result = matchResult;
+}
+
+void Replay::TruncateTo(int ticks) {
+    if (ticks >= tickCount) return;
+
+    // Re-encode the runs before the cut; the last one stays open so recording can continue
+    FlushRun();
+    std::vector<uint8_t> encoded;
+    encoded.swap(inputs);
+    tickCount = 0;
+    size_t offset = 0;
+    uint8_t flags;
+    uint32_t length;
+    while (tickCount < ticks && ReadRun(encoded, offset, flags, length)) {
+        uint32_t kept = length < (uint32_t)(ticks - tickCount) ? length : (uint32_t)(ticks - tickCount);
+        if (runLength > 0 && flags != runFlags) FlushRun();
+        runFlags = flags;
+        runLength += kept;
+        tickCount += (int)kept;
+    }
+}
+
+void Replay::FlushRun() {
+    if (runLength == 0) return;
+    if (runLength == 1) {
+        inputs.push_back(runFlags);
+    } else {
+        inputs.push_back(runFlags | RUN_FOLLOWS_BIT);
+        WriteVarint(inputs, runLength - 1);
+    }
+    runLength = 0;
+}
+
+bool Replay::Save(const char* path) const {
+    ReplayFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = REPLAY_FILE_MAGIC;
+    header.version = REPLAY_FILE_VERSION;
+    header.seed = seed;
+    header.mapHash = mapHash;
+    header.tickRate = SIM_TICK_RATE;
+    header.hiderCount = config.hiderCount;
+    header.hidingPhaseDuration = config.hidingPhaseDuration;
+    header.seekingPhaseDuration = config.seekingPhaseDuration;
+    header.tagRange = config.tagRange;
+    header.hiderAttackCooldown = config.hiderAttackCooldown;
+    header.result = result;
+    header.tickCount = (uint32_t)tickCount;
+    header.inputBytes = (uint32_t)inputs.size();
+
+    FILE* out = fopen(path, "wb");
+    if (!out) return false;
+    bool written = fwrite(&header, sizeof(header), 1, out) == 1 &&
+                   (inputs.empty() || fwrite(inputs.data(), 1, inputs.size(), out) == inputs.size());
+    return fclose(out) == 0 && written;
+}
+
+bool Replay::Load(const char* path) {
+    FILE* in = fopen(path, "rb");
+    if (!in) return false;
+
+    ReplayFileHeader header;
+    bool ok = fread(&header, sizeof(header), 1, in) == 1 &&
+              header.magic == REPLAY_FILE_MAGIC && header.version == REPLAY_FILE_VERSION &&
+              header.tickRate == SIM_TICK_RATE && header.hiderCount > 0 && header.hiderCount <= REPLAY_MAX_HIDERS &&
+              IsValidSetting(header.hidingPhaseDuration) && IsValidSetting(header.seekingPhaseDuration) &&
+              IsValidSetting(header.tagRange) && IsValidSetting(header.hiderAttackCooldown);
+    if (ok) {
+        // The input has to be in the file before anything is allocated for it
+        long inputStart = ftell(in);
+        ok = inputStart >= 0 && fseek(in, 0, SEEK_END) == 0;
+        long fileEnd = ok ? ftell(in) : -1;
+        ok = ok && fileEnd >= inputStart && (uint64_t)(fileEnd - inputStart) >= header.inputBytes &&
+             fseek(in, inputStart, SEEK_SET) == 0;
+    }
+    if (ok) {
+        inputs.resize(header.inputBytes);
+        ok = inputs.empty() || fread(inputs.data(), 1, inputs.size(), in) == inputs.size();
+    }
+    fclose(in);
+    if (!ok) {
+        inputs.clear();
+        return false;
+    }
+
+    seed = header.seed;
+    mapHash = header.mapHash;
+    config.hiderCount = header.hiderCount;
+    config.hidingPhaseDuration = header.hidingPhaseDuration;
+    config.seekingPhaseDuration = header.seekingPhaseDuration;
+    config.tagRange = header.tagRange;
+    config.hiderAttackCooldown = header.hiderAttackCooldown;
+    result = header.result;
+    tickCount = (int)header.tickCount;
+    runFlags = 0;
+    runLength = 0;
+    return true;
+}
+
+ReplaySeekerController::ReplaySeekerController() : replay(nullptr), readOffset(0), runFlags(0), runRemaining(0), ticksPlayed(0) {
+}
+
+void ReplaySeekerController::Start(const Replay* replayToPlay) {
+    replay = replayToPlay;
+    Reset();
+}
+
+void ReplaySeekerController::Reset() {
+    readOffset = 0;
+    runFlags = 0;
+    runRemaining = 0;
+    ticksPlayed = 0;
+}
+
+void ReplaySeekerController::SeekTo(int tick) {
+    Reset();
+    if (!replay) return;
+    while (ticksPlayed < tick && ReadRun(replay->inputs, readOffset, runFlags, runRemaining)) {
+        uint32_t skipped = runRemaining < (uint32_t)(tick - ticksPlayed) ? runRemaining : (uint32_t)(tick - ticksPlayed);
+        runRemaining -= skipped;
+        ticksPlayed += (int)skipped;
+    }
+}
+
+SeekerInput ReplaySeekerController::NextInput(const Simulation&) {
+    if (IsFinished()) return SeekerInput();
+
+    if (runRemaining == 0 && !ReadRun(replay->inputs, readOffset, runFlags, runRemaining)) {
+        return SeekerInput(); // Truncated recording
+    }
+
+    runRemaining--;
+    ticksPlayed++;
+    return SeekerInput(runFlags);
+}
+
+bool ReplaySeekerController::IsFinished() const {
+    return !replay || ticksPlayed >= replay->tickCount;
+}
@@ -0,0 +1,159 @@
+#include "resource_cache.h"
+
+ResourceCache::~ResourceCache() {
+    for (auto& entry : textures) {
+        TraceLog(LOG_WARNING, "RESOURCES: %s still had %d reference(s) at shutdown", entry.first.c_str(), entry.second.references);
+        UnloadTexture(entry.second.texture);
+    }
+    for (auto& entry : sounds) {
+        TraceLog(LOG_WARNING, "RESOURCES: %s still had %d reference(s) at shutdown", entry.first.c_str(), entry.second.references);
+        UnloadSound(entry.second.sound);
+    }
+    for (auto& entry : fonts) {
+        TraceLog(LOG_WARNING, "RESOURCES: %s still had %d reference(s) at shutdown", entry.first.c_str(), entry.second.references);
+        UnloadFont(entry.second.font);
+    }
+}
+
+size_t ResourceCache::GetResidentBytes() const {
+    size_t bytes = 0;
+    for (const auto& entry : textures) {
+        const Texture2D& texture = entry.second.texture;
+        bytes += (size_t)GetPixelDataSize(texture.width, texture.height, texture.format);
+    }
+    for (const auto& entry : sounds) {
+        const Sound& sound = entry.second.sound;
+        bytes += (size_t)sound.frameCount * sound.stream.channels * sound.stream.sampleSize / 8;
+    }
+    for (const auto& entry : fonts) {
+        const Texture2D& atlas = entry.second.font.texture;
+        bytes += (size_t)GetPixelDataSize(atlas.width, atlas.height, atlas.format);
+    }
+    return bytes;
+}
+
+Texture2D ResourceCache::AcquireTexture(const char* path) {
+    auto found = textures.find(path);
+    if (found != textures.end()) {
+        found->second.references++;
+        return found->second.texture;
+    }
+    if (!archive.Exists(path)) return Texture2D{0};
+
+    Image image = archive.ReadImage(path);
+    decodeCount++;
+    if (image.data == NULL) return Texture2D{0};
+    Texture2D texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+    if (texture.id == 0) return texture;
+    textures[path] = {texture, 1};
+    return texture;
+}
+
+bool ResourceCache::ReleaseTexture(Texture2D texture) {
+    if (texture.id == 0) return false;
+    for (auto entry = textures.begin(); entry != textures.end(); ++entry) {
+        if (entry->second.texture.id != texture.id) continue;
+        if (--entry->second.references == 0) {
+            UnloadTexture(entry->second.texture);
+            textures.erase(entry);
+        }
+        return true;
+    }
+    return false;
+}
+
+Sound ResourceCache::AcquireSound(const char* path) {
+    auto found = sounds.find(path);
+    if (found != sounds.end()) {
+        found->second.references++;
+        return found->second.sound;
+    }
+    if (!archive.Exists(path)) return Sound{0};
+
+    Wave wave = archive.ReadWave(path);
+    decodeCount++;
+    if (wave.data == NULL) return Sound{0};
+    Sound sound = LoadSoundFromWave(wave);
+    UnloadWave(wave);
+    if (sound.frameCount == 0) return sound;
+    sounds[path] = {sound, 1};
+    return sound;
+}
+
+bool ResourceCache::ReleaseSound(Sound sound) {
+    if (sound.stream.buffer == NULL) return false;
+    for (auto entry = sounds.begin(); entry != sounds.end(); ++entry) {
+        if (entry->second.sound.stream.buffer != sound.stream.buffer) continue;
+        if (--entry->second.references == 0) {
+            UnloadSound(entry->second.sound);
+            sounds.erase(entry);
+        }
+        return true;
+    }
+    return false;
+}
+
+Font ResourceCache::AcquireFont(const char* path) {
+    auto found = fonts.find(path);
+    if (found != fonts.end()) {
+        found->second.references++;
+        return found->second.font;
+    }
+    if (!archive.Exists(path)) return Font{0};
+
+    Font font = archive.ReadFont(path);
+    decodeCount++;
+    if (font.texture.id == 0 || font.texture.id == GetFontDefault().texture.id) return Font{0};
+    fonts[path] = {font, 1};
+    return font;
+}
+
+bool ResourceCache::ReleaseFont(Font font) {
+    if (font.texture.id == 0) return false;
+    for (auto entry = fonts.begin(); entry != fonts.end(); ++entry) {
+        if (entry->second.font.texture.id != font.texture.id) continue;
+        if (--entry->second.references == 0) {
+            UnloadFont(entry->second.font);
+            fonts.erase(entry);
+        }
+        return true;
+    }
+    return false;
+}
+
+Texture2D ResourceCache::InsertTexture(const char* path, Texture2D texture) {
+    if (texture.id == 0) return texture;
+    auto found = textures.find(path);
+    if (found != textures.end()) {
+        UnloadTexture(texture); // Loaded meanwhile; the caller shares that one instead
+        found->second.references++;
+        return found->second.texture;
+    }
+    textures[path] = {texture, 1};
+    return texture;
+}
+
+Sound ResourceCache::InsertSound(const char* path, Sound sound) {
+    if (sound.frameCount == 0) return sound;
+    auto found = sounds.find(path);
+    if (found != sounds.end()) {
+        UnloadSound(sound);
+        found->second.references++;
+        return found->second.sound;
+    }
+    sounds[path] = {sound, 1};
+    return sound;
+}
+
+Font ResourceCache::InsertFont(const char* path, Font font) {
+    if (font.texture.id == 0) return font;
+    auto found = fonts.find(path);
+    if (found != fonts.end()) {
+        UnloadFont(font);
+        found->second.references++;
+        return found->second.font;
+    }
+    fonts[path] = {font, 1};
+    return font;
+}
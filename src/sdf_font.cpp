@@ -0,0 +1,182 @@
+#include "sdf_font.h"
+#include "constants.h"
+#include "mapped_file.h"
+#include "rlgl.h"  // For rlGetVersion
+#include <cstdio>  // For fopen, fwrite, snprintf
+#include <cstring> // For memcpy
+#include <string>
+
+// raylib's SDF example shader: alpha holds the distance, 0.5 on the outline. Written once,
+// with the GLSL dialect's differences behind macros; a header per graphics API defines them.
+static const char* SDF_FRAGMENT_SHADER = R"(
+IN vec2 fragTexCoord;
+IN vec4 fragColor;
+uniform sampler2D texture0;
+void main() {
+    float distanceFromOutline = TEXTURE(texture0, fragTexCoord).a - 0.5;
+    float distanceChangePerFragment = length(vec2(dFdx(distanceFromOutline), dFdy(distanceFromOutline)));
+    float alpha = smoothstep(-distanceChangePerFragment, distanceChangePerFragment, distanceFromOutline);
+    FRAG_COLOR = vec4(fragColor.rgb, fragColor.a * alpha);
+}
+)";
+
+// GLSL_VERSION header for the API raylib is running on, or NULL on OpenGL 1.1, which has no shaders
+static const char* GetShaderHeader() {
+    switch (rlGetVersion()) {
+        case RL_OPENGL_21:
+            return "#version 120\n#define IN varying\n#define TEXTURE texture2D\n#define FRAG_COLOR gl_FragColor\n";
+        case RL_OPENGL_ES_20:
+            return "#version 100\n#extension GL_OES_standard_derivatives : enable\nprecision mediump float;\n"
+                   "#define IN varying\n#define TEXTURE texture2D\n#define FRAG_COLOR gl_FragColor\n";
+        case RL_OPENGL_ES_30:
+            return "#version 300 es\nprecision mediump float;\n"
+                   "#define IN in\n#define TEXTURE texture\nout vec4 finalColor;\n#define FRAG_COLOR finalColor\n";
+        case RL_OPENGL_33:
+        case RL_OPENGL_43:
+            return "#version 330\n#define IN in\n#define TEXTURE texture\nout vec4 finalColor;\n#define FRAG_COLOR finalColor\n";
+        default:
+            return NULL;
+    }
+}
+
+Shader SdfFont::shader = {0};
+
+static uint64_t HashFontFile(const unsigned char* data, int size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (int i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static bool ReadCache(const char* path, uint64_t fontHash, Font& font, Image& atlas) {
+    MappedFile file;
+    if (!file.Open(path) || file.size < sizeof(SdfFontFileHeader)) return false;
+
+    const SdfFontFileHeader* header = (const SdfFontFileHeader*)file.data;
+    if (header->magic != SDF_FONT_MAGIC || header->version != SDF_FONT_VERSION || header->fontHash != fontHash ||
+        header->baseSize != SDF_FONT_BASE_SIZE || header->glyphCount != SDF_FONT_GLYPH_COUNT ||
+        header->atlasWidth <= 0 || header->atlasHeight <= 0) {
+        return false;
+    }
+    size_t glyphBytes = (size_t)header->glyphCount * sizeof(SdfFontFileGlyph);
+    size_t atlasBytes = (size_t)header->atlasWidth * header->atlasHeight * 2;
+    if (file.size != sizeof(SdfFontFileHeader) + glyphBytes + atlasBytes) return false;
+
+    const SdfFontFileGlyph* glyphs = (const SdfFontFileGlyph*)(file.data + sizeof(SdfFontFileHeader));
+    font = {0};
+    font.baseSize = header->baseSize;
+    font.glyphCount = header->glyphCount;
+    font.glyphs = (GlyphInfo*)MemAlloc((unsigned int)(font.glyphCount * sizeof(GlyphInfo)));
+    font.recs = (Rectangle*)MemAlloc((unsigned int)(font.glyphCount * sizeof(Rectangle)));
+    for (int i = 0; i < font.glyphCount; ++i) {
+        font.glyphs[i].value = glyphs[i].value;
+        font.glyphs[i].offsetX = glyphs[i].offsetX;
+        font.glyphs[i].offsetY = glyphs[i].offsetY;
+        font.glyphs[i].advanceX = glyphs[i].advanceX;
+        font.glyphs[i].image = {0};
+        font.recs[i] = glyphs[i].rec;
+    }
+
+    atlas = {0};
+    atlas.data = MemAlloc((unsigned int)atlasBytes);
+    memcpy(atlas.data, file.data + sizeof(SdfFontFileHeader) + glyphBytes, atlasBytes);
+    atlas.width = header->atlasWidth;
+    atlas.height = header->atlasHeight;
+    atlas.mipmaps = 1;
+    atlas.format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA;
+    return true;
+}
+
+static bool WriteCache(const char* path, uint64_t fontHash, const Font& font, const Image& atlas) {
+    if (!DirectoryExists(FONT_CACHE_DIRECTORY)) {
+        MakeDirectory(FONT_CACHE_DIRECTORY);
+    }
+    FILE* out = fopen(path, "wb");
+    if (!out) return false;
+
+    SdfFontFileHeader header = {};
+    header.magic = SDF_FONT_MAGIC;
+    header.version = SDF_FONT_VERSION;
+    header.fontHash = fontHash;
+    header.baseSize = font.baseSize;
+    header.glyphCount = font.glyphCount;
+    header.atlasWidth = atlas.width;
+    header.atlasHeight = atlas.height;
+    bool written = fwrite(&header, sizeof(header), 1, out) == 1;
+    for (int i = 0; i < font.glyphCount && written; ++i) {
+        SdfFontFileGlyph glyph = {font.glyphs[i].value, font.glyphs[i].offsetX, font.glyphs[i].offsetY,
+                                  font.glyphs[i].advanceX, font.recs[i]};
+        written = fwrite(&glyph, sizeof(glyph), 1, out) == 1;
+    }
+    size_t atlasBytes = (size_t)atlas.width * atlas.height * 2;
+    written = written && fwrite(atlas.data, 1, atlasBytes, out) == atlasBytes;
+    return fclose(out) == 0 && written;
+}
+
+bool SdfFont::Bake(const unsigned char* fileData, int dataSize, Font& font, Image& atlas) {
+    uint64_t fontHash = HashFontFile(fileData, dataSize);
+    char path[256];
+    // Not TextFormat: its buffers are shared, and this may run on a worker thread
+    snprintf(path, sizeof(path), "%s/%016llx.hsfont", FONT_CACHE_DIRECTORY, (unsigned long long)fontHash);
+    if (ReadCache(path, fontHash, font, atlas)) return true;
+
+    font = {0};
+    font.baseSize = SDF_FONT_BASE_SIZE;
+    font.glyphCount = SDF_FONT_GLYPH_COUNT;
+    font.glyphs = LoadFontData(fileData, dataSize, font.baseSize, NULL, font.glyphCount, FONT_SDF);
+    if (font.glyphs == NULL) return false;
+
+    // SDF glyphs come with their own padding, so the atlas adds none
+    atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, font.baseSize, 0, 1);
+    for (int i = 0; i < font.glyphCount; ++i) {
+        UnloadImage(font.glyphs[i].image); // Only the atlas is drawn from
+        font.glyphs[i].image = {0};
+    }
+    if (atlas.format != PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA || !WriteCache(path, fontHash, font, atlas)) {
+        TraceLog(LOG_WARNING, "FONT: Could not cache %s", path);
+    }
+    return true;
+}
+
+Font SdfFont::Upload(Font font, Image atlas) {
+    font.texture = LoadTextureFromImage(atlas);
+    SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR); // The shader reads distances between texels
+    UnloadImage(atlas);
+    return font;
+}
+
+Font SdfFont::Load(const unsigned char* fileData, int dataSize) {
+    Font font = {0};
+    Image atlas = {0};
+    if (!Bake(fileData, dataSize, font, atlas)) return Font{0};
+    return Upload(font, atlas);
+}
+
+void SdfFont::Draw(Font font, const char* text, Vector2 position, float fontSize, float spacing, Color tint) {
+    bool sdf = BeginDraw(font);
+    DrawTextEx(font, text, position, fontSize, spacing, tint);
+    if (sdf) EndDraw();
+}
+
+bool SdfFont::BeginDraw(Font font) {
+    if (font.texture.id == 0 || font.texture.id == GetFontDefault().texture.id) return false;
+    if (shader.id == 0) {
+        const char* header = GetShaderHeader();
+        if (header == NULL) return false; // Drawn without the shader: softer edges, but readable
+        std::string source = std::string(header) + SDF_FRAGMENT_SHADER;
+        shader = LoadShaderFromMemory(NULL, source.c_str());
+    }
+    BeginShaderMode(shader);
+    return true;
+}
+
+void SdfFont::EndDraw() {
+    EndShaderMode();
+}
+
+void SdfFont::UnloadShader() {
+    if (shader.id > 0) ::UnloadShader(shader);
+    shader = {0};
+}
@@ -0,0 +1,139 @@
+#include "seeker_bot.h"
+#include "simulation.h"
+#include "constants.h"
+#include "raymath.h"
+#include <cfloat> // For FLT_MAX
+
+SeekerBot::SeekerBot(SeekerPolicy botPolicy) : policy(botPolicy), targetHider(-1), targetSpot(-1), goal{0, 0},
+                                               lastPlanTick(0), pathIndex(0) {
+}
+
+void SeekerBot::Reset() {
+    targetHider = -1;
+    targetSpot = -1;
+    lastPlanTick = 0;
+    path.clear();
+    pathIndex = 0;
+    visitedSpots.clear();
+}
+
+int SeekerBot::FindNearestHider(const Simulation& sim, bool visibleOnly) const {
+    const HiderState& s = sim.hiders.Front();
+    int nearest = -1;
+    float nearestDistSqr = FLT_MAX;
+    for (int i = 0; i < sim.hiders.count; ++i) {
+        if (s.isTagged[i]) continue;
+        if (visibleOnly && !sim.player.IsLookingAt(s.position[i])) continue;
+        float distSqr = Vector2DistanceSqr(sim.player.position, s.position[i]);
+        if (distSqr < nearestDistSqr) {
+            nearestDistSqr = distSqr;
+            nearest = i;
+        }
+    }
+    return nearest;
+}
+
+int SeekerBot::FindNearestUnvisitedSpot(const Simulation& sim) {
+    ArrayView<Vector2> spots = sim.gameMap.GetHidingSpots();
+    if (spots.empty()) return -1;
+    if (visitedSpots.size() != spots.size()) visitedSpots.assign(spots.size(), 0);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        int nearest = -1;
+        float nearestDistSqr = FLT_MAX;
+        for (int i = 0; i < (int)spots.size(); ++i) {
+            if (visitedSpots[i]) continue;
+            float distSqr = Vector2DistanceSqr(sim.player.position, spots[i]);
+            if (distSqr < nearestDistSqr) {
+                nearestDistSqr = distSqr;
+                nearest = i;
+            }
+        }
+        if (nearest >= 0) return nearest;
+        visitedSpots.assign(spots.size(), 0); // Checked them all, start another round
+    }
+    return -1;
+}
+
+void SeekerBot::PlanTo(const Simulation& sim, Vector2 target) {
+    goal = target;
+    lastPlanTick = sim.tickCount;
+    pathIndex = 0;
+    if (!sim.gameMap.GetPathfinder().FindPath(sim.player.position, target, path)) {
+        path.assign(1, target); // No route on the grid, head straight for it
+    }
+}
+
+uint8_t SeekerBot::SteerAlongPath(const Simulation& sim) {
+    while (pathIndex < (int)path.size() - 1 &&
+           Vector2Distance(sim.player.position, path[pathIndex]) < SEEKER_BOT_WAYPOINT_RADIUS) {
+        pathIndex++;
+    }
+    if (pathIndex >= (int)path.size()) return 0;
+
+    // Quantize the steering direction to the eight directions the keys allow.
+    // A component counts once it is more than sin(22.5 degrees) of the direction.
+    Vector2 toWaypoint = Vector2Subtract(path[pathIndex], sim.player.position);
+    float length = Vector2Length(toWaypoint);
+    if (length <= 1.0f) return 0;
+
+    uint8_t flags = 0;
+    float threshold = length * 0.3827f;
+    if (toWaypoint.y < -threshold) flags |= SEEKER_INPUT_UP;
+    if (toWaypoint.y > threshold) flags |= SEEKER_INPUT_DOWN;
+    if (toWaypoint.x < -threshold) flags |= SEEKER_INPUT_LEFT;
+    if (toWaypoint.x > threshold) flags |= SEEKER_INPUT_RIGHT;
+    return flags;
+}
+
+SeekerInput SeekerBot::NextInput(const Simulation& sim) {
+    if (policy == SeekerPolicy::IDLE || sim.currentPhase != GamePhase::SEEKING) {
+        return SeekerInput();
+    }
+
+    const HiderState& s = sim.hiders.Front();
+    uint8_t flags = 0;
+
+    // Tag anything already in range and in view before moving on
+    sim.hiderHash.Query(sim.player.position, sim.player.tagRange, [&](int hiderIndex, Vector2) {
+        if (!s.isTagged[hiderIndex] && sim.player.CanTag(s.position[hiderIndex])) {
+            flags |= SEEKER_INPUT_TAG;
+            return true;
+        }
+        return false;
+    });
+
+    // A sweeping seeker keeps chasing a hider it has seen until it is tagged or lost from view
+    int hider = FindNearestHider(sim, policy == SeekerPolicy::SWEEP);
+    if (hider < 0 && targetHider >= 0 && !s.isTagged[targetHider] &&
+        Vector2Distance(sim.player.position, s.position[targetHider]) < PLAYER_VISION_RADIUS) {
+        hider = targetHider;
+    }
+
+    if (hider >= 0) {
+        if (hider != targetHider || targetSpot >= 0 || sim.tickCount - lastPlanTick >= SEEKER_BOT_REPLAN_TICKS) {
+            targetHider = hider;
+            targetSpot = -1;
+            PlanTo(sim, s.position[hider]);
+        }
+        // Sprint after it while there is stamina; Player only starts a sprint above half
+        if (sim.player.sprintValue > 0.0f) flags |= SEEKER_INPUT_SPRINT;
+    } else {
+        targetHider = -1;
+        ArrayView<Vector2> spots = sim.gameMap.GetHidingSpots();
+        // lastPlanTick is when the walk to the spot started, paths to spots are never replanned
+        if (targetSpot >= 0 && (Vector2Distance(sim.player.position, spots[targetSpot]) < SEEKER_BOT_SPOT_CHECKED_RADIUS ||
+                                sim.tickCount - lastPlanTick >= SEEKER_BOT_SPOT_GIVE_UP_TICKS)) {
+            visitedSpots[targetSpot] = 1;
+            targetSpot = -1;
+        }
+        if (targetSpot < 0) {
+            targetSpot = FindNearestUnvisitedSpot(sim);
+            if (targetSpot < 0) return SeekerInput(flags);
+            PlanTo(sim, spots[targetSpot]);
+        }
+    }
+
+    flags |= SteerAlongPath(sim);
+    return SeekerInput(flags);
+}
@@ -0,0 +1,269 @@
+#include "simulation.h"
+#include "constants.h"
+#include "random.h"
+#include "profiler.h"
+#include "raymath.h"
+#include <cstring>     // For memcpy
+#include <type_traits> // For std::is_trivially_copyable
+
+static_assert(std::is_trivially_copyable<SimulationSnapshotHeader>::value, "Snapshots are copied as raw bytes");
+
+Simulation::Simulation() {
+}
+
+void Simulation::LoadMap() {
+    gameMap.Load();
+}
+
+void Simulation::Reset(uint64_t seed) {
+    matchSeed = seed;
+    player.tagRange = config.tagRange;
+    player.rotation = 0.0f;
+    player.showAlert = false;
+
+    // Spawn points come from the map layout (the corners, with padding, on the built-in map)
+    float padding = PLAYER_RADIUS + 50.0f;
+    ArrayView<Vector2> spawnPoints = gameMap.spawnPoints;
+    RandomStream spawnRandom(matchSeed, RANDOM_STREAM_SPAWN);
+
+    Vector2 playerSpawnPos = {0, 0};
+    bool spawnPosFound = false;
+    int attempts = 0;
+    const int maxAttempts = 10; // Try up to 10 times to find a valid corner
+
+    // Randomly select a corner and check if it's valid
+    while (!spawnPosFound && !spawnPoints.empty() && attempts < maxAttempts) {
+        int cornerIndex = spawnRandom.NextInt((int)spawnPoints.size());
+        Vector2 potentialPos = spawnPoints[cornerIndex];
+
+        if (gameMap.IsPositionValid(potentialPos, PLAYER_RADIUS)) {
+            playerSpawnPos = potentialPos;
+            spawnPosFound = true;
+        }
+        attempts++;
+    }
+
+    // Fallback if no valid corner found (shouldn't happen with reasonable maps)
+    if (!spawnPosFound) {
+        playerSpawnPos = {padding, padding}; // Default to top-left if no valid corner found
+    }
+
+    player.Init(playerSpawnPos); // Initialize player at the selected valid position
+
+    hiders.Resize(config.hiderCount, matchSeed);
+    hiders.attackCooldown = config.hiderAttackCooldown;
+    hiderHash.Init(SPATIAL_HASH_CELL_SIZE, gameMap.width, gameMap.height); // Holds the starting positions while spawning
+    for (int i = 0; i < config.hiderCount; ++i) {
+        Vector2 pos;
+        bool positionOk;
+        int attempts = 0;
+        const int maxSpawnAttempts = 100; // Limit attempts to prevent infinite loops
+        do {
+            positionOk = true;
+            pos = {(float)(spawnRandom.NextInt(gameMap.width - 200) + 100), (float)(spawnRandom.NextInt(gameMap.height - 200) + 100)}; // Generate position away from edges
+            attempts++;
+
+            // Check distance from player
+            if (Vector2DistanceSqr(pos, player.position) < (PLAYER_RADIUS + HIDER_RADIUS + 50) * (PLAYER_RADIUS + HIDER_RADIUS + 50)) {
+                positionOk = false;
+                continue;
+            }
+
+            // Check distance from already assigned hider starting positions
+            if (hiderHash.AnyInRadius(pos, HIDER_RADIUS * 4)) {
+                positionOk = false;
+                continue;
+            }
+
+            // Check validity against map obstacles, and keep spawns off the walls
+            if (!gameMap.IsPositionValid(pos, HIDER_RADIUS) || gameMap.GetClearance(pos) < HIDER_RADIUS * 2) {
+                positionOk = false;
+            }
+
+        } while(!positionOk && attempts < maxSpawnAttempts);
+
+        if (attempts >= maxSpawnAttempts) {
+            // Fallback: place at a default spot or allow potentially invalid spot (depending on desired game behavior)
+            // For now, we'll just use the last attempted position, which might be invalid.
+            // A better approach might be to place them near the player's start or a known valid spot.
+        }
+
+        hiderHash.Insert(i, pos);
+        hiders.Spawn(i, pos);
+    }
+
+    fleeField.Reset();
+    hidersRemaining = config.hiderCount;
+    for (int s = 0; s < 3; ++s) {
+        hidingDwell[s] = 0.0f;
+        seekingDwell[s] = 0.0f;
+    }
+    tickCount = 0;
+    result = MatchResult::NONE;
+    lastGameTime = 0.0f;
+    seekingPhaseStarted = false;
+    tagEvents = 0;
+    StartHidingPhase(); // Sets gameTimer, currentPhase, and hider FSM states
+}
+
+void Simulation::StartHidingPhase() {
+    currentPhase = GamePhase::HIDING;
+    gameTimer = config.hidingPhaseDuration;
+    hidingPhaseElapsed = 0.0f;
+
+    for (int i = 0; i < hiders.count; ++i) {
+        if (!hiders.Front().isTagged[i]) {
+            hiders.Front().hidingState[i] = HiderHidingFSMState::SCOUTING;
+        }
+    }
+}
+
+void Simulation::StartSeekingPhase() {
+    currentPhase = GamePhase::SEEKING;
+    gameTimer = config.seekingPhaseDuration;
+    seekingPhaseStarted = true;
+
+    for (int i = 0; i < hiders.count; ++i) {
+        if (!hiders.Front().isTagged[i]) {
+            hiders.Front().seekingState[i] = HiderSeekingFSMState::IDLING;
+        }
+    }
+    RebuildHiderHash(); // Drop the hiding spot claims before the first seeking tick
+}
+
+void Simulation::RebuildHiderHash() {
+    hiderHash.Clear();
+    for (int i = 0; i < hiders.count; ++i) {
+        if (currentPhase == GamePhase::HIDING) {
+            hiders.AddToSpatialHash(i, hiderHash);
+        } else if (!hiders.Front().isTagged[i]) {
+            hiderHash.Insert(i, hiders.Front().position[i]);
+        }
+    }
+}
+
+void Simulation::Tick(float deltaTime, const SeekerInput& input) {
+    PROFILE_SCOPE("Sim tick");
+    seekingPhaseStarted = false;
+    tagEvents = 0;
+    if (IsOver()) return;
+    tickCount++;
+
+    if (currentPhase == GamePhase::HIDING) {
+        hidingPhaseElapsed += deltaTime;
+
+        // Option to skip hiding phase for debugging/testing
+        if (input.Has(SEEKER_INPUT_SKIP_HIDING)) {
+            StartSeekingPhase();
+            return;
+        }
+
+        // Hiders find spots during the entire hiding phase
+        RebuildHiderHash();
+        hiders.Update(deltaTime, currentPhase, player, gameMap, hiderHash, fleeField);
+        AccumulateDwell(deltaTime);
+
+        gameTimer -= deltaTime;
+
+        if (gameTimer <= 0) {
+            StartSeekingPhase();
+        }
+        return;
+    }
+
+    // --- SEEKING PHASE ---
+    gameTimer -= deltaTime;
+    player.Update(deltaTime, input, gameMap, hiders, hiderHash); // Hash is from the end of the last tick, hiders haven't moved since
+    {
+        PROFILE_SCOPE("Flee field");
+        fleeField.Update(gameMap.GetPathfinder(), player.position);
+    }
+
+    bool playerTaggedByHider = false;
+
+    hiders.Update(deltaTime, currentPhase, player, gameMap, hiderHash, fleeField);
+    tagEvents += hiders.tagEvents;
+    AccumulateDwell(deltaTime);
+
+    for (int i = 0; i < hiders.count; ++i) {
+        if (!hiders.Front().isTagged[i] && hiders.Front().seekingState[i] == HiderSeekingFSMState::ATTACKING) {
+            float distanceToPlayer = Vector2Distance(player.position, hiders.Front().position[i]);
+            float collisionDistance = HIDER_RADIUS + PLAYER_RADIUS;
+            if (distanceToPlayer <= collisionDistance) {
+                playerTaggedByHider = true;
+            }
+        }
+    }
+
+    RebuildHiderHash();
+
+    if (input.Has(SEEKER_INPUT_TAG)) {
+        hiderHash.Query(player.position, player.tagRange, [&](int hiderIndex, Vector2) {
+            if (!hiders.Front().isTagged[hiderIndex] && player.CanTag(hiders.Front().position[hiderIndex])) {
+                hiders.Front().isTagged[hiderIndex] = 1;
+                hiders.taggedAt[hiderIndex] = config.seekingPhaseDuration - gameTimer;
+                tagEvents++;
+            }
+            return false;
+        });
+    }
+
+    hidersRemaining = hiders.CountRemaining();
+
+    CheckWinLossConditions(playerTaggedByHider);
+}
+
+void Simulation::AccumulateDwell(float deltaTime) {
+    const HiderState& s = hiders.Front();
+    for (int i = 0; i < hiders.count; ++i) {
+        if (s.isTagged[i]) continue;
+        if (currentPhase == GamePhase::HIDING) {
+            hidingDwell[(int)s.hidingState[i]] += deltaTime;
+        } else {
+            seekingDwell[(int)s.seekingState[i]] += deltaTime;
+        }
+    }
+}
+
+void Simulation::SaveSnapshot(unsigned char* out) const {
+    SimulationSnapshotHeader header;
+    header.sim = *this;
+    header.player = player;
+    header.hiders = hiders;
+    header.arenaBytes = hiders.arena.Size();
+    memcpy(out, &header, sizeof(header));
+    memcpy(out + sizeof(header), hiders.arena.Data(), hiders.arena.Size());
+}
+
+void Simulation::LoadSnapshot(const unsigned char* in) {
+    SimulationSnapshotHeader header;
+    memcpy(&header, in, sizeof(header));
+    if (header.hiders.count != hiders.count || header.arenaBytes != hiders.arena.Size()) {
+        hiders.Resize(header.hiders.count, header.hiders.matchSeed); // Lay the arena out for that many hiders
+    }
+    memcpy(hiders.arena.Data(), in + sizeof(header), hiders.arena.Size());
+
+    static_cast<SimulationState&>(*this) = header.sim;
+    static_cast<PlayerState&>(player) = header.player;
+    static_cast<HiderBatchState&>(hiders) = header.hiders;
+
+    // Derived from the state above, so rebuilding them gives what the next tick would have seen
+    fleeField.Reset();
+    hiderHash.Init(SPATIAL_HASH_CELL_SIZE, gameMap.width, gameMap.height);
+    RebuildHiderHash();
+}
+
+void Simulation::CheckWinLossConditions(bool playerGotTagged) {
+    if (currentPhase != GamePhase::SEEKING || IsOver()) return;
+
+    if (hidersRemaining == 0) {
+        result = MatchResult::SEEKER_WON;
+        lastGameTime = config.seekingPhaseDuration - gameTimer;
+    } else if (gameTimer <= 0) {
+        result = MatchResult::TIME_UP;
+        lastGameTime = 0;
+    } else if (playerGotTagged) {
+        result = MatchResult::SEEKER_TAGGED;
+        lastGameTime = config.seekingPhaseDuration - gameTimer;
+    }
+}
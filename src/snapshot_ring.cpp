@@ -0,0 +1,32 @@
+#include "snapshot_ring.h"
+#include "simulation.h"
+#include "constants.h"
+
+SnapshotRing::SnapshotRing() : slotSize(0), capacity(SNAPSHOT_RING_CAPACITY), head(0), count(0) {
+}
+
+void SnapshotRing::Clear() {
+    head = 0;
+    count = 0;
+}
+
+void SnapshotRing::Push(const Simulation& sim) {
+    size_t size = sim.GetSnapshotSize();
+    if (size != slotSize) {
+        slotSize = size;
+        storage.assign(slotSize * capacity, 0);
+        Clear();
+    }
+
+    sim.SaveSnapshot(&storage[head * slotSize]);
+    head = (head + 1) % capacity;
+    if (count < capacity) count++;
+}
+
+bool SnapshotRing::Pop(Simulation& sim) {
+    if (count == 0) return false;
+    head = (head + capacity - 1) % capacity;
+    count--;
+    sim.LoadSnapshot(&storage[head * slotSize]);
+    return true;
+}
@@ -0,0 +1,28 @@
+#include "spatial_hash.h"
+#include <cmath>     // For ceilf
+#include <algorithm> // For std::fill
+
+SpatialHash::SpatialHash() : cellSize(1.0f), cols(0), rows(0) {
+}
+
+void SpatialHash::Init(float hashCellSize, int worldWidth, int worldHeight) {
+    cellSize = hashCellSize;
+    cols = (int)ceilf(worldWidth / cellSize);
+    rows = (int)ceilf(worldHeight / cellSize);
+    if (cols < 1) cols = 1;
+    if (rows < 1) rows = 1;
+    cellHead.assign((size_t)cols * rows, -1);
+    entries.clear();
+}
+
+void SpatialHash::Clear() {
+    std::fill(cellHead.begin(), cellHead.end(), -1);
+    entries.clear(); // Keeps its capacity, so a rebuild every tick does not allocate
+}
+
+void SpatialHash::Insert(int id, Vector2 position) {
+    if (cellHead.empty()) return;
+    int cell = CellCoord(position.y, rows) * cols + CellCoord(position.x, cols);
+    entries.push_back({position, id, cellHead[cell]});
+    cellHead[cell] = (int)entries.size() - 1;
+}
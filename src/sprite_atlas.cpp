@@ -0,0 +1,99 @@
+#include "sprite_atlas.h"
+#include "constants.h"
+#include <algorithm> // For std::sort, std::max
+
+SpriteAtlas::SpriteAtlas(const AssetArchive* archive) : texture{0}, archive(archive) {
+}
+
+int SpriteAtlas::AddFile(const char* path) {
+    Image image = {0};
+    if (archive) {
+        image = archive->ReadImage(path);
+    } else if (FileExists(path)) {
+        image = LoadImage(path);
+    }
+    if (image.data == NULL) return -1;
+    return AddImage(image);
+}
+
+int SpriteAtlas::AddImage(Image image) {
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    pending.push_back(image);
+    frames.push_back({0, 0, (float)image.width, (float)image.height});
+    return (int)frames.size() - 1;
+}
+
+void SpriteAtlas::Build() {
+    if (pending.empty()) return;
+
+    // Shelf packing, tallest first, widening the atlas until everything fits in a square-ish sheet
+    std::vector<int> order(pending.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = (int)i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return pending[a].height > pending[b].height; });
+
+    int atlasWidth = SPRITE_ATLAS_MIN_SIZE;
+    int atlasHeight = 0;
+    for (;;) {
+        int x = 0;
+        int y = 0;
+        int shelfHeight = 0;
+        for (int i : order) {
+            int w = pending[i].width + SPRITE_ATLAS_PADDING;
+            int h = pending[i].height + SPRITE_ATLAS_PADDING;
+            if (x + w > atlasWidth) {
+                x = 0;
+                y += shelfHeight;
+                shelfHeight = 0;
+            }
+            frames[i].x = (float)x;
+            frames[i].y = (float)y;
+            x += w;
+            shelfHeight = std::max(shelfHeight, h);
+        }
+        atlasHeight = y + shelfHeight;
+        if (atlasHeight <= atlasWidth) break;
+        atlasWidth *= 2;
+    }
+
+    Image sheet = GenImageColor(atlasWidth, atlasHeight, BLANK);
+    for (size_t i = 0; i < pending.size(); ++i) {
+        Rectangle source = {0, 0, (float)pending[i].width, (float)pending[i].height};
+        ImageDraw(&sheet, pending[i], source, frames[i], WHITE);
+        UnloadImage(pending[i]);
+    }
+    pending.clear();
+
+    texture = LoadTextureFromImage(sheet);
+    UnloadImage(sheet);
+}
+
+void SpriteAtlas::Unload() {
+    for (Image& image : pending) UnloadImage(image);
+    pending.clear();
+    frames.clear();
+    if (texture.id > 0) UnloadTexture(texture);
+    texture = {0};
+}
+
+SpriteBatch::SpriteBatch() : atlas(nullptr) {
+}
+
+void SpriteBatch::Begin(const SpriteAtlas& spriteAtlas) {
+    atlas = &spriteAtlas;
+    instances.clear();
+}
+
+void SpriteBatch::Add(int frame, Vector2 position, float rotation, float size) {
+    instances.push_back({frame, position, rotation, size});
+}
+
+void SpriteBatch::End() {
+    if (atlas && atlas->texture.id > 0) {
+        for (const SpriteInstance& sprite : instances) {
+            Rectangle destRec = {sprite.position.x, sprite.position.y, sprite.size, sprite.size};
+            Vector2 origin = {sprite.size / 2.0f, sprite.size / 2.0f};
+            DrawTexturePro(atlas->texture, atlas->GetFrame(sprite.frame), destRec, origin, sprite.rotation, WHITE);
+        }
+    }
+    instances.clear();
+}
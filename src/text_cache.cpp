@@ -0,0 +1,177 @@
+#include "text_cache.h"
+#include "sdf_font.h"
+#include "rlgl.h"
+#include <cstring> // For strcmp, strlen
+
+static void HashBytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+const TextRun& TextCache::Get(Font font, const char* text, float fontSize, float spacing, float outline, TextAlign align) {
+    uint64_t key = 14695981039346656037ull; // FNV-1a
+    HashBytes(key, text, strlen(text));
+    HashBytes(key, &font.texture.id, sizeof(font.texture.id));
+    HashBytes(key, &fontSize, sizeof(fontSize));
+    HashBytes(key, &spacing, sizeof(spacing));
+    HashBytes(key, &outline, sizeof(outline));
+    HashBytes(key, &align, sizeof(align));
+
+    auto found = runs.find(key);
+    if (found != runs.end()) {
+        TextRun& run = found->second;
+        if (run.font.texture.id == font.texture.id && run.fontSize == fontSize && run.spacing == spacing &&
+            run.outline == outline && run.align == align && strcmp(run.text.c_str(), text) == 0) {
+            run.lastUsed = GetTime();
+            return run;
+        }
+    } else {
+        Trim();
+    }
+
+    // New, or a different run that hashed the same; either way it is laid out again under key
+    TextRun& run = runs[key];
+    run.text = text;
+    run.font = font;
+    run.fontSize = fontSize;
+    run.spacing = spacing;
+    run.outline = outline;
+    run.align = align;
+    Layout(run);
+    run.lastUsed = GetTime();
+    return run;
+}
+
+void TextCache::Clear() {
+    runs.clear();
+}
+
+// The same placement as DrawTextEx, with MeasureTextEx's size, but done once per run
+void TextCache::Layout(TextRun& run) {
+    const Font& font = run.font;
+    run.quads.clear();
+    run.size = {0, 0};
+    if (font.texture.id == 0 || font.glyphs == NULL || font.baseSize <= 0) return;
+
+    float scale = run.fontSize / (float)font.baseSize;
+    float padding = (float)font.glyphPadding;
+    float lineHeight = run.fontSize * (1.0f + TEXT_LINE_GAP);
+    std::vector<size_t> lineStarts = {0}; // First quad of each line
+    std::vector<float> lineWidths;
+    float x = 0;
+    float y = 0;
+    int lineLength = 0;
+
+    for (const char* c = run.text.c_str(); *c != '\0';) {
+        int bytes = 0;
+        int codepoint = GetCodepointNext(c, &bytes);
+        c += bytes;
+
+        if (codepoint == '\n') {
+            lineWidths.push_back(lineLength > 0 ? x - run.spacing : 0);
+            lineStarts.push_back(run.quads.size());
+            x = 0;
+            y += lineHeight;
+            lineLength = 0;
+            continue;
+        }
+
+        int index = GetGlyphIndex(font, codepoint);
+        const GlyphInfo& glyph = font.glyphs[index];
+        const Rectangle& rec = font.recs[index];
+        if (codepoint != ' ' && codepoint != '\t') {
+            TextQuad quad;
+            quad.dest = {x + (glyph.offsetX - padding) * scale, y + (glyph.offsetY - padding) * scale,
+                         (rec.width + 2 * padding) * scale, (rec.height + 2 * padding) * scale};
+            quad.uv = {(rec.x - padding) / font.texture.width, (rec.y - padding) / font.texture.height,
+                       (rec.width + 2 * padding) / font.texture.width, (rec.height + 2 * padding) / font.texture.height};
+            quad.outline = false;
+            run.quads.push_back(quad);
+        }
+        x += (glyph.advanceX != 0 ? glyph.advanceX : rec.width) * scale + run.spacing;
+        lineLength++;
+    }
+    lineWidths.push_back(lineLength > 0 ? x - run.spacing : 0);
+
+    for (float width : lineWidths) {
+        if (width > run.size.x) run.size.x = width;
+    }
+    run.size.y = y + run.fontSize;
+
+    if (run.align == TextAlign::CENTER) {
+        for (size_t line = 0; line < lineWidths.size(); ++line) {
+            size_t end = line + 1 < lineStarts.size() ? lineStarts[line + 1] : run.quads.size();
+            float shift = (run.size.x - lineWidths[line]) / 2;
+            for (size_t i = lineStarts[line]; i < end; ++i) run.quads[i].dest.x += shift;
+        }
+    }
+
+    // The outline is four offset copies under the text, so it goes first
+    if (run.outline > 0) {
+        const Vector2 offsets[4] = {{-run.outline, 0}, {run.outline, 0}, {0, -run.outline}, {0, run.outline}};
+        size_t glyphCount = run.quads.size();
+        std::vector<TextQuad> outlined;
+        outlined.reserve(glyphCount * 5);
+        for (const Vector2& offset : offsets) {
+            for (size_t i = 0; i < glyphCount; ++i) {
+                TextQuad quad = run.quads[i];
+                quad.dest.x += offset.x;
+                quad.dest.y += offset.y;
+                quad.outline = true;
+                outlined.push_back(quad);
+            }
+        }
+        outlined.insert(outlined.end(), run.quads.begin(), run.quads.end());
+        run.quads.swap(outlined);
+    }
+}
+
+void TextCache::Draw(const TextRun& run, Vector2 position, Color tint, float scale, Color outlineColor) {
+    if (run.quads.empty()) return;
+
+    bool sdf = SdfFont::BeginDraw(run.font);
+    rlCheckRenderBatchLimit(4 * (int)run.quads.size());
+    rlSetTexture(run.font.texture.id);
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    bool outlining = !run.quads[0].outline; // Forces the first colour to be set
+    for (const TextQuad& quad : run.quads) {
+        if (quad.outline != outlining) {
+            outlining = quad.outline;
+            Color color = outlining ? outlineColor : tint;
+            rlColor4ub(color.r, color.g, color.b, color.a);
+        }
+        float left = position.x + quad.dest.x * scale;
+        float top = position.y + quad.dest.y * scale;
+        float right = left + quad.dest.width * scale;
+        float bottom = top + quad.dest.height * scale;
+        float u0 = quad.uv.x;
+        float v0 = quad.uv.y;
+        float u1 = quad.uv.x + quad.uv.width;
+        float v1 = quad.uv.y + quad.uv.height;
+
+        rlTexCoord2f(u0, v0);
+        rlVertex2f(left, top);
+        rlTexCoord2f(u0, v1);
+        rlVertex2f(left, bottom);
+        rlTexCoord2f(u1, v1);
+        rlVertex2f(right, bottom);
+        rlTexCoord2f(u1, v0);
+        rlVertex2f(right, top);
+    }
+    rlEnd();
+    rlSetTexture(0);
+    if (sdf) SdfFont::EndDraw();
+}
+
+void TextCache::Trim() {
+    if ((int)runs.size() < TEXT_CACHE_MAX_RUNS) return;
+    double now = GetTime();
+    for (auto run = runs.begin(); run != runs.end();) {
+        if (now - run->second.lastUsed > TEXT_CACHE_IDLE_SECONDS) run = runs.erase(run);
+        else ++run;
+    }
+}
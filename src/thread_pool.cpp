@@ -0,0 +1,79 @@
+#include "thread_pool.h"
+#include <algorithm> // For std::min, std::max
+
+ThreadPool::ThreadPool(int workerCount) : job(nullptr), jobCount(0), chunkSize(1), nextChunk(0),
+                                          pendingWorkers(0), generation(0), stopping(false) {
+    if (workerCount < 0) {
+        workerCount = (int)std::thread::hardware_concurrency() - 1;
+    }
+    for (int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeWorkers.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::ParallelFor(int count, int minChunk, const std::function<void(int begin, int end)>& body) {
+    if (count <= 0) return;
+    minChunk = std::max(minChunk, 1);
+    if (workers.empty() || count <= minChunk) {
+        body(0, count);
+        return;
+    }
+
+    // A few chunks per thread so a slow chunk doesn't hold everyone up
+    int threadCount = (int)workers.size() + 1;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &body;
+        jobCount = count;
+        chunkSize = std::max(minChunk, (count + threadCount * 4 - 1) / (threadCount * 4));
+        nextChunk.store(0);
+        pendingWorkers = (int)workers.size();
+        generation++;
+    }
+    wakeWorkers.notify_all();
+
+    RunChunks();
+
+    // Every worker has to check in before body goes out of scope
+    std::unique_lock<std::mutex> lock(mutex);
+    jobDone.wait(lock, [this] { return pendingWorkers == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::RunChunks() {
+    for (;;) {
+        int begin = nextChunk.fetch_add(1) * chunkSize;
+        if (begin >= jobCount) return;
+        (*job)(begin, std::min(begin + chunkSize, jobCount));
+    }
+}
+
+void ThreadPool::WorkerLoop() {
+    uint64_t seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeWorkers.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+
+        RunChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pendingWorkers == 0) jobDone.notify_one();
+        }
+    }
+}
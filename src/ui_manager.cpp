@@ -1,20 +1,13 @@
 #include "ui_manager.h"
+#include "resource_cache.h"
+#include "asset_loader.h"
 #include "raymath.h"
-#include <string>
 
 
 UIManager::UIManager() : currentInstructionPage(1) {
-    if (FileExists("kiwi_soda.ttf")) { 
-        titleTextFont = LoadFont("kiwi_soda.ttf");
-    } else {
-        titleTextFont = GetFontDefault();
-    }
-
-    if (FileExists("rainy_hearts.ttf")) { 
-        bodyTextFont = LoadFont("rainy_hearts.ttf");
-    } else {
-        bodyTextFont = GetFontDefault();
-    }
+    // The real fonts come with the menu assets; until then text is drawn in raylib's own
+    titleTextFont = GetFontDefault();
+    bodyTextFont = GetFontDefault();
     
     titleBg = {0};
     howToPlayBg = {0};
@@ -25,37 +18,100 @@ UIManager::UIManager() : currentInstructionPage(1) {
     buttonClickSound = {0};
 }
 
-void UIManager::LoadAssets() {
-    if (FileExists("title_screen_bg.png")) titleBg = LoadTexture("title_screen_bg.png");
-    if (FileExists("how_to_play_bg.png")) howToPlayBg = LoadTexture("how_to_play_bg.png");
-    if (FileExists("instruction_1.png")) howToPlayInstructions1 = LoadTexture("instruction_1.png");
-    if (FileExists("instruction_2.png")) howToPlayInstructions2 = LoadTexture("instruction_2.png");
-    if (FileExists("game_over_bg.png")) gameOverBg = LoadTexture("game_over_bg.png"); 
+void UIManager::RequestSharedAssets(AssetLoader& loader, int group) {
+    loader.Request(AssetKind::FONT, "kiwi_soda.ttf", group);
+    loader.Request(AssetKind::FONT, "rainy_hearts.ttf", group);
+    loader.Request(AssetKind::SOUND, "button_click.mp3", group);
+}
 
-    // Load main menu music
-    if (FileExists("main_menu.mp3")) {
-        mainMenuMusic = LoadMusicStream("main_menu.mp3");
+void UIManager::RequestScreenAssets(GameScreen screen, AssetLoader& loader, int group) {
+    switch (screen) {
+        case GameScreen::MAIN_MENU:
+            loader.Request(AssetKind::TEXTURE, "title_screen_bg.png", group);
+            break;
+        case GameScreen::HOW_TO_PLAY:
+            loader.Request(AssetKind::TEXTURE, "how_to_play_bg.png", group);
+            loader.Request(AssetKind::TEXTURE, "instruction_1.png", group);
+            loader.Request(AssetKind::TEXTURE, "instruction_2.png", group);
+            break;
+        case GameScreen::GAME_OVER:
+            loader.Request(AssetKind::TEXTURE, "game_over_bg.png", group);
+            break;
+        default:
+            break;
+    }
+}
+
+void UIManager::LoadSharedAssets(ResourceCache& resources) {
+    titleTextFont = resources.AcquireFont("kiwi_soda.ttf");
+    if (titleTextFont.texture.id == 0) titleTextFont = GetFontDefault();
+    bodyTextFont = resources.AcquireFont("rainy_hearts.ttf");
+    if (bodyTextFont.texture.id == 0) bodyTextFont = GetFontDefault();
+    text.Clear(); // Anything laid out so far was in the default font
+
+    // Load main menu music (How to Play keeps it going, so it isn't tied to the menu's own assets)
+    mainMenuMusic = resources.archive.OpenMusic("main_menu.mp3");
+    if (mainMenuMusic.stream.buffer != NULL) {
         SetMusicVolume(mainMenuMusic, 0.5f); // Set volume to 50%
         PlayMusicStream(mainMenuMusic);
     }
 
     // Load button click sound
-    if (FileExists("button_click.mp3")) {
-        buttonClickSound = LoadSound("button_click.mp3");
+    buttonClickSound = resources.AcquireSound("button_click.mp3");
+    if (buttonClickSound.frameCount > 0) {
         SetSoundVolume(buttonClickSound, 0.5f); // Set volume to 50%
     }
 }
 
-void UIManager::UnloadAssets() {
-    if (titleBg.id > 0) UnloadTexture(titleBg);
-    if (howToPlayBg.id > 0) UnloadTexture(howToPlayBg);
-    if (howToPlayInstructions1.id > 0) UnloadTexture(howToPlayInstructions1); 
-    if (howToPlayInstructions2.id > 0) UnloadTexture(howToPlayInstructions2); 
-    if (gameOverBg.id > 0) UnloadTexture(gameOverBg);
-    if (titleTextFont.texture.id != GetFontDefault().texture.id) UnloadFont(titleTextFont); 
-    if (bodyTextFont.texture.id != GetFontDefault().texture.id) UnloadFont(bodyTextFont); 
+void UIManager::LoadScreenAssets(GameScreen screen, ResourceCache& resources) {
+    switch (screen) {
+        case GameScreen::MAIN_MENU:
+            titleBg = resources.AcquireTexture("title_screen_bg.png");
+            break;
+        case GameScreen::HOW_TO_PLAY:
+            howToPlayBg = resources.AcquireTexture("how_to_play_bg.png");
+            howToPlayInstructions1 = resources.AcquireTexture("instruction_1.png");
+            howToPlayInstructions2 = resources.AcquireTexture("instruction_2.png");
+            break;
+        case GameScreen::GAME_OVER:
+            gameOverBg = resources.AcquireTexture("game_over_bg.png");
+            break;
+        default:
+            break;
+    }
+}
+
+void UIManager::UnloadScreenAssets(GameScreen screen, ResourceCache& resources) {
+    switch (screen) {
+        case GameScreen::MAIN_MENU:
+            resources.ReleaseTexture(titleBg);
+            titleBg = {0};
+            break;
+        case GameScreen::HOW_TO_PLAY:
+            resources.ReleaseTexture(howToPlayBg);
+            resources.ReleaseTexture(howToPlayInstructions1);
+            resources.ReleaseTexture(howToPlayInstructions2);
+            howToPlayBg = {0};
+            howToPlayInstructions1 = {0};
+            howToPlayInstructions2 = {0};
+            break;
+        case GameScreen::GAME_OVER:
+            resources.ReleaseTexture(gameOverBg);
+            gameOverBg = {0};
+            break;
+        default:
+            break;
+    }
+}
+
+void UIManager::UnloadAssets(ResourceCache& resources) {
+    UnloadScreenAssets(GameScreen::MAIN_MENU, resources);
+    UnloadScreenAssets(GameScreen::HOW_TO_PLAY, resources);
+    UnloadScreenAssets(GameScreen::GAME_OVER, resources);
+    resources.ReleaseFont(titleTextFont); // Not from the cache if it fell back to the default
+    resources.ReleaseFont(bodyTextFont);
     if (mainMenuMusic.stream.buffer != NULL) UnloadMusicStream(mainMenuMusic);
-    if (buttonClickSound.stream.buffer != NULL) UnloadSound(buttonClickSound);
+    resources.ReleaseSound(buttonClickSound);
 }
 
 bool UIManager::DrawButton(Rectangle bounds, const char* text, int fontSize, Color baseColor, Color hoverColor, Color textColor) {
@@ -104,25 +160,35 @@ bool UIManager::DrawButton(Rectangle bounds, const char* text, int fontSize, Col
     DrawRectangleRounded(buttonFaceBounds, roundness, segments, currentButtonFaceColor);
 
     Font currentButtonFont = (this->bodyTextFont.texture.id != 0) ? this->bodyTextFont : GetFontDefault();
-    float textWidth = MeasureTextEx(currentButtonFont, text, (float)fontSize, 1).x;
+    Color textOutlineColor = Fade(BLACK, 0.5f); 
+    float textOutlineThickness = 1; 
+    const TextRun& label = this->text.Get(currentButtonFont, text, (float)fontSize, 1, textOutlineThickness);
     
     Vector2 textPosition = {
-        buttonFaceBounds.x + (buttonFaceBounds.width - textWidth) / 2,
+        buttonFaceBounds.x + (buttonFaceBounds.width - label.size.x) / 2,
         buttonFaceBounds.y + (buttonFaceBounds.height - fontSize) / 2
     };
 
-    Color textOutlineColor = Fade(BLACK, 0.5f); 
-    int textOutlineThickness = 1; 
-
-    DrawTextEx(currentButtonFont, text, (Vector2){textPosition.x - textOutlineThickness, textPosition.y}, (float)fontSize, 1, textOutlineColor);
-    DrawTextEx(currentButtonFont, text, (Vector2){textPosition.x + textOutlineThickness, textPosition.y}, (float)fontSize, 1, textOutlineColor);
-    DrawTextEx(currentButtonFont, text, (Vector2){textPosition.x, textPosition.y - textOutlineThickness}, (float)fontSize, 1, textOutlineColor);
-    DrawTextEx(currentButtonFont, text, (Vector2){textPosition.x, textPosition.y + textOutlineThickness}, (float)fontSize, 1, textOutlineColor);
-    DrawTextEx(currentButtonFont, text, textPosition, (float)fontSize, 1, currentButtonTextColor);
+    TextCache::Draw(label, textPosition, currentButtonTextColor, 1, textOutlineColor);
     
     return clicked;
 }
 
+void UIManager::DrawLoadingScreen(float progress) {
+    ClearBackground(BLACK);
+
+    // Drawn before any of our fonts are in, so this uses raylib's default font
+    const char* loadingText = "Loading...";
+    int loadingFontSize = MENU_BUTTON_FONT_SIZE;
+    int textWidth = MeasureText(loadingText, loadingFontSize);
+    DrawText(loadingText, (SCREEN_WIDTH - textWidth) / 2, SCREEN_HEIGHT / 2 - 50, loadingFontSize, TEXT_COLOR);
+
+    Rectangle bar = {SCREEN_WIDTH / 2.0f - 200, SCREEN_HEIGHT / 2.0f, 400, 20};
+    DrawRectangleRec(bar, DARKGRAY);
+    DrawRectangleRec({bar.x, bar.y, bar.width * Clamp(progress, 0.0f, 1.0f), bar.height}, BUTTON_HOVER_COLOR);
+    DrawRectangleLinesEx(bar, 2, TEXT_COLOR);
+}
+
 void UIManager::DrawMainMenu(GameScreen& currentScreen, bool& quitGameFlag, bool& wantsToStartNewGame) {
     // Update music stream
     if (mainMenuMusic.stream.buffer != NULL) {
@@ -145,27 +211,29 @@ void UIManager::DrawMainMenu(GameScreen& currentScreen, bool& quitGameFlag, bool
     float bobAmount = 4.0f;   
     float yAnimationOffset = sinf(time * bobSpeed) * bobAmount;
 
-    Vector2 titleLine1Size = MeasureTextEx(currentTitleFont, titleLine1, titleFontSize, 1); 
+    const TextRun& titleLine1Run = text.Get(currentTitleFont, titleLine1, titleFontSize);
+    Vector2 titleLine1Size = titleLine1Run.size;
     Vector2 titleLine1BasePos = {
         (SCREEN_WIDTH - titleLine1Size.x) / 2,  
         SCREEN_HEIGHT * 0.18f                   
     };
     Vector2 shadowOffset = {3, 3};
     Color shadowColor = Fade(BLACK, 0.6f);
-    DrawTextEx(currentTitleFont, titleLine1, 
+    TextCache::Draw(titleLine1Run, 
            {titleLine1BasePos.x + shadowOffset.x, titleLine1BasePos.y + shadowOffset.y + yAnimationOffset}, 
-           titleFontSize, 1, shadowColor);
-    DrawTextEx(currentTitleFont, titleLine1, {titleLine1BasePos.x, titleLine1BasePos.y + yAnimationOffset}, titleFontSize, 1, titleColor);
+           shadowColor);
+    TextCache::Draw(titleLine1Run, {titleLine1BasePos.x, titleLine1BasePos.y + yAnimationOffset}, titleColor);
 
-    Vector2 titleLine2Size = MeasureTextEx(currentTitleFont, titleLine2, titleFontSize, 1); 
+    const TextRun& titleLine2Run = text.Get(currentTitleFont, titleLine2, titleFontSize);
+    Vector2 titleLine2Size = titleLine2Run.size;
     Vector2 titleLine2BasePos = {
         (SCREEN_WIDTH - titleLine2Size.x) / 2,   
         titleLine1BasePos.y + titleLine1Size.y + lineSpacing
     };
-    DrawTextEx(currentTitleFont, titleLine2, 
+    TextCache::Draw(titleLine2Run, 
            {titleLine2BasePos.x + shadowOffset.x, titleLine2BasePos.y + shadowOffset.y + yAnimationOffset}, 
-           titleFontSize, 1, shadowColor);
-    DrawTextEx(currentTitleFont, titleLine2, {titleLine2BasePos.x, titleLine2BasePos.y + yAnimationOffset}, titleFontSize, 1, titleColor);
+           shadowColor);
+    TextCache::Draw(titleLine2Run, {titleLine2BasePos.x, titleLine2BasePos.y + yAnimationOffset}, titleColor);
 
     float buttonsStartY = titleLine2BasePos.y + titleLine2Size.y + 70; 
 
@@ -204,7 +272,8 @@ void UIManager::DrawHowToPlay(GameScreen& currentScreen) {
     float pageTitleFontSize = (float)HOW_TO_PLAY_SCREEN_TITLE_FONT_SIZE; 
     Color pageTitleColor = MAIN_TITLE_COLOR;
 
-    Vector2 pageTitleSize = MeasureTextEx(screenTitleFont, pageTitleText, pageTitleFontSize, 1);
+    const TextRun& pageTitle = text.Get(screenTitleFont, pageTitleText, pageTitleFontSize);
+    Vector2 pageTitleSize = pageTitle.size;
     float titleTextHeight = pageTitleSize.y; 
 
     float titleYPosition = 50.0f; 
@@ -218,13 +287,13 @@ void UIManager::DrawHowToPlay(GameScreen& currentScreen) {
     Vector2 shadowOffset = {3, 3};      
     Color shadowColor = Fade(BLACK, 0.6f);
 
-    DrawTextEx(screenTitleFont, pageTitleText, 
+    TextCache::Draw(pageTitle, 
                {pageTitleBasePos.x + shadowOffset.x, pageTitleBasePos.y + shadowOffset.y}, 
-               pageTitleFontSize, 1, shadowColor);
+               shadowColor);
 
-    DrawTextEx(screenTitleFont, pageTitleText, 
+    TextCache::Draw(pageTitle, 
                pageTitleBasePos, 
-               pageTitleFontSize, 1, pageTitleColor);
+               pageTitleColor);
 
     Texture2D currentInstructionImage = {0};
     if (currentInstructionPage == 1 && howToPlayInstructions1.id > 0) {
@@ -268,10 +337,8 @@ void UIManager::DrawHowToPlay(GameScreen& currentScreen) {
 
     } else {
         float placeholderY = imageStartY + availableHeightForImage / 2 - MENU_BUTTON_FONT_SIZE / 2; 
-        const char* placeholderMsg = TextFormat("Instruction Page %d Image Missing", currentInstructionPage);
-        DrawTextEx(bodyTextFont, placeholderMsg, 
-                   {(SCREEN_WIDTH - MeasureTextEx(bodyTextFont, placeholderMsg, MENU_BUTTON_FONT_SIZE, 1).x) / 2 , placeholderY}, 
-                   MENU_BUTTON_FONT_SIZE, 1, RED);
+        const TextRun& placeholderMsg = text.Get(bodyTextFont, TextFormat("Instruction Page %d Image Missing", currentInstructionPage), MENU_BUTTON_FONT_SIZE);
+        TextCache::Draw(placeholderMsg, {(SCREEN_WIDTH - placeholderMsg.size.x) / 2 , placeholderY}, RED);
     }
 
     float buttonY = SCREEN_HEIGHT - 70.0f; 
@@ -300,18 +367,20 @@ void UIManager::DrawHowToPlay(GameScreen& currentScreen) {
 void UIManager::DrawInGameHUD(float timer, int hidersLeft, float sprintValue) {
     Font currentHudFont = bodyTextFont; // Use hudTextFont if loaded, else bodyTextFont
 
-    DrawTextEx(currentHudFont, TextFormat("Time: %02d:%02d", (int)timer / 60, (int)timer % 60),
-               {20, 20}, (float)HUD_TEXT_FONT_SIZE, 1, HUD_TEXT_COLOR);
+    TextCache::Draw(text.Get(currentHudFont, TextFormat("Time: %02d:%02d", (int)timer / 60, (int)timer % 60), (float)HUD_TEXT_FONT_SIZE),
+               {20, 20}, HUD_TEXT_COLOR);
 
-    DrawTextEx(currentHudFont, TextFormat("Hiders Left: %d", hidersLeft),
-                {SCREEN_WIDTH - MeasureTextEx(currentHudFont, TextFormat("Hiders Left: %d", NUM_HIDERS), (float)HUD_TEXT_FONT_SIZE, 1).x - 20, 20}, 
-               (float)HUD_TEXT_FONT_SIZE, 1, HUD_TEXT_COLOR);
+    // Right-aligned to the widest the count gets, so the text doesn't shift as it goes down
+    float hidersLeftWidth = text.Get(currentHudFont, TextFormat("Hiders Left: %d", NUM_HIDERS), (float)HUD_TEXT_FONT_SIZE).size.x;
+    TextCache::Draw(text.Get(currentHudFont, TextFormat("Hiders Left: %d", hidersLeft), (float)HUD_TEXT_FONT_SIZE),
+                {SCREEN_WIDTH - hidersLeftWidth - 20, 20}, 
+               HUD_TEXT_COLOR);
     float sprintBarWidth = 200;
     float sprintBarHeight = 20;
     DrawRectangle(20, SCREEN_HEIGHT - 40.0f, (int)sprintBarWidth, (int)sprintBarHeight, DARKGRAY);
     DrawRectangle(20, SCREEN_HEIGHT - 40.0f, (int)(sprintBarWidth * (sprintValue / SPRINT_MAX)), (int)sprintBarHeight, SKYBLUE);
     DrawRectangleLines(20, (int)(SCREEN_HEIGHT - 40.0f), (int)sprintBarWidth, (int)sprintBarHeight, LIGHTGRAY);
-    DrawTextEx(currentHudFont, "Sprint", {25 + 200.0f, SCREEN_HEIGHT - 40.0f}, (float)HUD_TEXT_FONT_SIZE * 0.7f, 1, HUD_TEXT_COLOR);
+    TextCache::Draw(text.Get(currentHudFont, "Sprint", (float)HUD_TEXT_FONT_SIZE * 0.7f), {25 + 200.0f, SCREEN_HEIGHT - 40.0f}, HUD_TEXT_COLOR);
 }
 
 
@@ -320,10 +389,10 @@ void UIManager::DrawPauseMenu(GameScreen& currentScreen, bool& quitGame, bool& r
 
     const char* pauseText = "PAUSED";
     Font currentPauseTitleFont = titleTextFont.texture.id != 0 ? titleTextFont : bodyTextFont;
-    float textWidth = MeasureTextEx(currentPauseTitleFont, pauseText, (float)PAUSE_MENU_TITLE_FONT_SIZE, 1).x;
-    DrawTextEx(currentPauseTitleFont, pauseText, 
-               {(SCREEN_WIDTH - textWidth) / 2, SCREEN_HEIGHT * 0.25f}, 
-               (float)PAUSE_MENU_TITLE_FONT_SIZE, 1, PAUSE_MENU_TEXT_COLOR);
+    const TextRun& pauseTitle = text.Get(currentPauseTitleFont, pauseText, (float)PAUSE_MENU_TITLE_FONT_SIZE);
+    TextCache::Draw(pauseTitle, 
+               {(SCREEN_WIDTH - pauseTitle.size.x) / 2, SCREEN_HEIGHT * 0.25f}, 
+               PAUSE_MENU_TEXT_COLOR);
 
     Rectangle resumeButton = {SCREEN_WIDTH / 2.0f - 150, SCREEN_HEIGHT * 0.4f, 300, 60};
     if (DrawButton(resumeButton, "Resume", MENU_BUTTON_FONT_SIZE, BUTTON_COLOR, BUTTON_HOVER_COLOR, MENU_BUTTON_TEXT_COLOR)) {
@@ -359,11 +428,12 @@ void UIManager::DrawGameOverScreen(GameScreen& currentScreen, bool playerWon, fl
     Color primaryGameOverColor = playerWon ? GAME_OVER_WIN_COLOR : GAME_OVER_LOSS_COLOR; 
     float primaryTextFontSize = (float)GAME_OVER_TITLE_FONT_SIZE; 
 
-    Vector2 primaryTextSize = MeasureTextEx(currentTitleFont, primaryGameOverText, primaryTextFontSize, 1);
+    const TextRun& primaryTextRun = text.Get(currentTitleFont, primaryGameOverText, primaryTextFontSize);
+    Vector2 primaryTextSize = primaryTextRun.size;
     float primaryTextY = SCREEN_HEIGHT * 0.28f - primaryTextSize.y / 2; 
-    DrawTextEx(currentTitleFont, primaryGameOverText, 
+    TextCache::Draw(primaryTextRun, 
                {(SCREEN_WIDTH - primaryTextSize.x) / 2, primaryTextY}, 
-               primaryTextFontSize, 1, primaryGameOverColor);
+               primaryGameOverColor);
 
     const char* reasonText;
     if (playerWon) {
@@ -382,38 +452,13 @@ void UIManager::DrawGameOverScreen(GameScreen& currentScreen, bool playerWon, fl
     float paddingBelowPrimaryText = 50.0f; 
     float reasonTextCalculatedY = primaryTextY + primaryTextSize.y + paddingBelowPrimaryText;
 
-    std::string reasonStr = reasonText;
-    size_t newlinePos = reasonStr.find('\n');
+    // Each line centred, with the gap between them a tenth of the font size
+    const TextRun& reasonRun = text.Get(currentBodyFont, reasonText, reasonTextFontSize, 1, 0, TextAlign::CENTER);
+    TextCache::Draw(reasonRun, 
+               {(SCREEN_WIDTH - reasonRun.size.x) / 2, reasonTextCalculatedY}, 
+               reasonTextColor);
 
-    if (newlinePos != std::string::npos) { 
-        std::string line1 = reasonStr.substr(0, newlinePos);
-        std::string line2 = reasonStr.substr(newlinePos + 1);
-        Vector2 line1Size = MeasureTextEx(currentBodyFont, line1.c_str(), reasonTextFontSize, 1);
-        Vector2 line2Size = MeasureTextEx(currentBodyFont, line2.c_str(), reasonTextFontSize, 1);
-        
-        DrawTextEx(currentBodyFont, line1.c_str(), 
-                   {(SCREEN_WIDTH - line1Size.x) / 2, reasonTextCalculatedY}, 
-                   reasonTextFontSize, 1, reasonTextColor);
-        DrawTextEx(currentBodyFont, line2.c_str(), 
-                   {(SCREEN_WIDTH - line2Size.x) / 2, reasonTextCalculatedY + line1Size.y + (reasonTextFontSize * 0.1f)},
-                   reasonTextFontSize, 1, reasonTextColor);
-    } else {
-        Vector2 singleLineSize = MeasureTextEx(currentBodyFont, reasonText, reasonTextFontSize, 1);
-        DrawTextEx(currentBodyFont, reasonText, 
-                   {(SCREEN_WIDTH - singleLineSize.x) / 2, reasonTextCalculatedY}, 
-                   reasonTextFontSize, 1, reasonTextColor);
-    }
-
-    float actualReasonTextHeight;
-    if (newlinePos != std::string::npos) {
-        std::string line1 = reasonStr.substr(0, newlinePos);
-        std::string line2 = reasonStr.substr(newlinePos + 1);
-        actualReasonTextHeight = MeasureTextEx(currentBodyFont, line1.c_str(), reasonTextFontSize, 1).y + 
-                                 MeasureTextEx(currentBodyFont, line2.c_str(), reasonTextFontSize, 1).y +
-                                 (reasonTextFontSize * 0.1f); 
-    } else {
-        actualReasonTextHeight = MeasureTextEx(currentBodyFont, reasonText, reasonTextFontSize, 1).y;
-    }
+    float actualReasonTextHeight = reasonRun.size.y;
     float buttonsStartY = reasonTextCalculatedY + actualReasonTextHeight + 60; 
 
     if (buttonsStartY < SCREEN_HEIGHT * 0.65f) buttonsStartY = SCREEN_HEIGHT * 0.65f; 
@@ -0,0 +1,184 @@
+// hidenseek-assetpack: packs the resources directory into the .hspak archive the game memory-maps at startup.
+//
+// Usage: hidenseek-assetpack [--raw] [resources_dir] [output.hspak]
+//
+// Images (PNG, JPG, BMP, TGA) are re-encoded as QOI, or stored as raw RGBA pixels with --raw,
+// which is larger but skips decoding altogether. Sounds and fonts are stored as they are: MP3
+// and OGG are already compact, and fonts are rasterized at load anyway. Anything else is left
+// out, including the .hsmap layout, which the game maps on its own.
+#include "asset_archive.h"
+#include "constants.h"
+#include <cstdio>  // For printf
+#include <cstring> // For strcmp
+#include <vector>
+
+namespace {
+
+// QOI encoder, following the reference implementation at qoiformat.org
+const unsigned char QOI_OP_INDEX = 0x00;
+const unsigned char QOI_OP_DIFF = 0x40;
+const unsigned char QOI_OP_LUMA = 0x80;
+const unsigned char QOI_OP_RUN = 0xc0;
+const unsigned char QOI_OP_RGB = 0xfe;
+const unsigned char QOI_OP_RGBA = 0xff;
+
+void PutBigEndian(std::vector<unsigned char>& out, uint32_t value) {
+    out.push_back((unsigned char)(value >> 24));
+    out.push_back((unsigned char)(value >> 16));
+    out.push_back((unsigned char)(value >> 8));
+    out.push_back((unsigned char)value);
+}
+
+std::vector<unsigned char> EncodeQoi(const unsigned char* pixels, int width, int height) {
+    std::vector<unsigned char> out;
+    out.reserve((size_t)width * height + 32);
+    out.insert(out.end(), {'q', 'o', 'i', 'f'});
+    PutBigEndian(out, (uint32_t)width);
+    PutBigEndian(out, (uint32_t)height);
+    out.push_back(4); // RGBA
+    out.push_back(0); // sRGB with linear alpha
+
+    Color index[64] = {};
+    Color previous = {0, 0, 0, 255};
+    int run = 0;
+    size_t pixelCount = (size_t)width * height;
+    for (size_t i = 0; i < pixelCount; ++i) {
+        Color pixel = {pixels[i * 4], pixels[i * 4 + 1], pixels[i * 4 + 2], pixels[i * 4 + 3]};
+        bool same = pixel.r == previous.r && pixel.g == previous.g && pixel.b == previous.b && pixel.a == previous.a;
+        if (same) {
+            run++;
+            if (run == 62 || i == pixelCount - 1) {
+                out.push_back(QOI_OP_RUN | (unsigned char)(run - 1));
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            out.push_back(QOI_OP_RUN | (unsigned char)(run - 1));
+            run = 0;
+        }
+
+        int hash = (pixel.r * 3 + pixel.g * 5 + pixel.b * 7 + pixel.a * 11) % 64;
+        const Color& cached = index[hash];
+        if (cached.r == pixel.r && cached.g == pixel.g && cached.b == pixel.b && cached.a == pixel.a) {
+            out.push_back(QOI_OP_INDEX | (unsigned char)hash);
+        } else if (pixel.a == previous.a) {
+            index[hash] = pixel;
+            signed char dr = (signed char)(pixel.r - previous.r);
+            signed char dg = (signed char)(pixel.g - previous.g);
+            signed char db = (signed char)(pixel.b - previous.b);
+            signed char drg = (signed char)(dr - dg);
+            signed char dbg = (signed char)(db - dg);
+            if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2) {
+                out.push_back(QOI_OP_DIFF | (unsigned char)((dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+            } else if (drg > -9 && drg < 8 && dg > -33 && dg < 32 && dbg > -9 && dbg < 8) {
+                out.push_back(QOI_OP_LUMA | (unsigned char)(dg + 32));
+                out.push_back((unsigned char)((drg + 8) << 4 | (dbg + 8)));
+            } else {
+                out.insert(out.end(), {QOI_OP_RGB, pixel.r, pixel.g, pixel.b});
+            }
+        } else {
+            index[hash] = pixel;
+            out.insert(out.end(), {QOI_OP_RGBA, pixel.r, pixel.g, pixel.b, pixel.a});
+        }
+        previous = pixel;
+    }
+    out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1}); // End marker
+    return out;
+}
+
+bool PackImage(const char* path, bool raw, AssetArchiveInput& input) {
+    Image image = LoadImage(path);
+    if (image.data == NULL) return false;
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    input.width = image.width;
+    input.height = image.height;
+    const unsigned char* pixels = (const unsigned char*)image.data;
+    if (raw) {
+        input.encoding = AssetEncoding::RGBA8;
+        input.data.assign(pixels, pixels + (size_t)image.width * image.height * 4);
+    } else {
+        input.encoding = AssetEncoding::QOI;
+        input.data = EncodeQoi(pixels, image.width, image.height);
+    }
+    UnloadImage(image);
+    return true;
+}
+
+bool PackStored(const char* path, AssetArchiveInput& input) {
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(path, &dataSize);
+    if (data == NULL) return false;
+    input.encoding = AssetEncoding::STORED;
+    input.width = 0;
+    input.height = 0;
+    input.data.assign(data, data + dataSize);
+    UnloadFileData(data);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool raw = false;
+    std::vector<const char*> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--raw") == 0) {
+            raw = true;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    const char* inputDirectory = paths.size() > 0 ? paths[0] : ".";
+    const char* outputPath = paths.size() > 1 ? paths[1] : ASSET_ARCHIVE_PATH;
+
+    if (!DirectoryExists(inputDirectory)) {
+        fprintf(stderr, "No directory '%s'\n", inputDirectory);
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    FilePathList files = LoadDirectoryFiles(inputDirectory);
+    std::vector<AssetArchiveInput> inputs;
+    size_t looseBytes = 0;
+    bool ok = true;
+    for (unsigned int i = 0; i < files.count; ++i) {
+        const char* path = files.paths[i];
+        AssetArchiveInput input;
+        input.name = GetFileName(path);
+
+        bool packed;
+        if (IsFileExtension(path, ".png;.jpg;.jpeg;.bmp;.tga")) {
+            packed = PackImage(path, raw, input);
+        } else if (IsFileExtension(path, ".mp3;.wav;.ogg;.flac;.qoa;.ttf;.otf")) {
+            packed = PackStored(path, input);
+        } else {
+            printf("Skipped %s\n", input.name.c_str());
+            continue;
+        }
+        if (!packed) {
+            fprintf(stderr, "Could not read '%s'\n", path);
+            ok = false;
+            continue;
+        }
+        if (input.name.size() >= (size_t)ASSET_ARCHIVE_NAME_LENGTH) {
+            fprintf(stderr, "Name too long for the archive: '%s'\n", input.name.c_str());
+            ok = false;
+            continue;
+        }
+        looseBytes += (size_t)GetFileLength(path);
+        inputs.push_back(std::move(input));
+    }
+    UnloadDirectoryFiles(files);
+    if (!ok) return 1;
+
+    if (!AssetArchive::Write(inputs, outputPath)) {
+        fprintf(stderr, "Could not write '%s'\n", outputPath);
+        return 1;
+    }
+
+    printf("Wrote %s: %d assets, %d KiB (%d KiB as loose files)\n", outputPath, (int)inputs.size(),
+           GetFileLength(outputPath) / 1024, (int)(looseBytes / 1024));
+    return 0;
+}
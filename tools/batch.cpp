@@ -0,0 +1,229 @@
+// hidenseek-batch: plays many headless matches in parallel and writes one CSV row per match,
+// for balancing the gameplay constants without sitting through the matches.
+//
+// Usage: hidenseek-batch [options]
+//     --matches <n>             matches to play (default 1000)
+//     --seed <n>                base seed; match i is seeded from (seed, i) (default 1)
+//     --threads <n>             worker threads including this one (default: all cores)
+//     --policy <p[,p...]>       seeker policies, idle, sweep or chase, cycled over the matches (default sweep)
+//     --hiders <n>              hiders per match (default NUM_HIDERS)
+//     --tag-range <px>          seeker tag range (default TAG_RANGE)
+//     --attack-cooldown <s>     hider attack cooldown (default HIDER_ATTACK_COOLDOWN)
+//     --seeking-duration <s>    seeking phase length (default SEEKING_PHASE_DURATION)
+//     --out <file>              results file (default batch_results.csv)
+//     --help                    print these options
+//
+// Every match gets its own world, so workers share nothing but the match counter. Rows are
+// written in match order once all matches are done, so a run's output depends only on its
+// arguments and not on the thread count.
+#include "simulation.h"
+#include "seeker_bot.h"
+#include "thread_pool.h"
+#include "random.h"
+#include "constants.h"
+#include <atomic>  // For the shared match counter
+#include <chrono>  // For steady_clock
+#include <cstdio>  // For fopen, fprintf, printf
+#include <cstdlib> // For strtol, strtoull, strtof
+#include <cstring> // For strcmp
+#include <string>
+#include <vector>
+
+namespace {
+
+struct MatchRecord {
+    uint64_t seed;
+    SeekerPolicy policy;
+    MatchResult result;
+    float lastGameTime;
+    int ticks;
+    int hidersTagged;
+    float hidingDwell[3];
+    float seekingDwell[3];
+    std::vector<float> hiderTaggedAt;
+    std::vector<int> hiderTagsLanded;
+};
+
+const char* PolicyName(SeekerPolicy policy) {
+    switch (policy) {
+        case SeekerPolicy::IDLE: return "idle";
+        case SeekerPolicy::SWEEP: return "sweep";
+        default: return "chase";
+    }
+}
+
+const char* ResultName(MatchResult result) {
+    switch (result) {
+        case MatchResult::SEEKER_WON: return "seeker_won";
+        case MatchResult::SEEKER_TAGGED: return "seeker_tagged";
+        case MatchResult::TIME_UP: return "time_up";
+        default: return "none";
+    }
+}
+
+void PrintUsage(FILE* out) {
+    fprintf(out, "Usage: hidenseek-batch [options]\n"
+                 "    --matches <n>             matches to play (default 1000)\n"
+                 "    --seed <n>                base seed; match i is seeded from (seed, i) (default 1)\n"
+                 "    --threads <n>             worker threads including this one (default: all cores)\n"
+                 "    --policy <p[,p...]>       seeker policies, idle, sweep or chase, cycled over the matches (default sweep)\n"
+                 "    --hiders <n>              hiders per match (default %d)\n"
+                 "    --tag-range <px>          seeker tag range (default %g)\n"
+                 "    --attack-cooldown <s>     hider attack cooldown (default %g)\n"
+                 "    --seeking-duration <s>    seeking phase length (default %g)\n"
+                 "    --out <file>              results file (default batch_results.csv)\n"
+                 "    --help                    show this message\n",
+            NUM_HIDERS, TAG_RANGE, HIDER_ATTACK_COOLDOWN, SEEKING_PHASE_DURATION);
+}
+
+bool ParsePolicies(const char* list, std::vector<SeekerPolicy>& policies) {
+    policies.clear();
+    std::string names(list);
+    size_t start = 0;
+    while (start <= names.size()) {
+        size_t end = names.find(',', start);
+        if (end == std::string::npos) end = names.size();
+        std::string name = names.substr(start, end - start);
+        if (name == "idle") {
+            policies.push_back(SeekerPolicy::IDLE);
+        } else if (name == "sweep") {
+            policies.push_back(SeekerPolicy::SWEEP);
+        } else if (name == "chase") {
+            policies.push_back(SeekerPolicy::CHASE);
+        } else {
+            fprintf(stderr, "Unknown seeker policy '%s'\n", name.c_str());
+            return false;
+        }
+        start = end + 1;
+    }
+    return !policies.empty();
+}
+
+void PlayMatch(Simulation& sim, SeekerBot& bot, uint64_t seed, MatchRecord& record) {
+    const float tickDelta = 1.0f / SIM_TICK_RATE;
+
+    sim.Reset(seed);
+    bot.Reset();
+    while (!sim.IsOver()) {
+        sim.Tick(tickDelta, bot.NextInput(sim));
+    }
+
+    record.seed = seed;
+    record.policy = bot.policy;
+    record.result = sim.result;
+    record.lastGameTime = sim.lastGameTime;
+    record.ticks = sim.tickCount;
+    record.hidersTagged = sim.hiders.count - sim.hidersRemaining;
+    for (int s = 0; s < 3; ++s) {
+        record.hidingDwell[s] = sim.hidingDwell[s];
+        record.seekingDwell[s] = sim.seekingDwell[s];
+    }
+    record.hiderTaggedAt.assign(sim.hiders.taggedAt.begin(), sim.hiders.taggedAt.end());
+    record.hiderTagsLanded.assign(sim.hiders.tagsLanded.begin(), sim.hiders.tagsLanded.end());
+}
+
+bool WriteResults(const char* path, const std::vector<MatchRecord>& records, int hiderCount) {
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "Could not open '%s' for writing\n", path);
+        return false;
+    }
+
+    fprintf(out, "match,seed,policy,outcome,last_game_time,ticks,hiders_tagged,"
+                 "scouting_s,moving_to_spot_s,hiding_s,idling_s,evading_s,attacking_s");
+    for (int i = 0; i < hiderCount; ++i) {
+        fprintf(out, ",hider%d_tagged_at,hider%d_tags_landed", i, i);
+    }
+    fprintf(out, "\n");
+
+    for (size_t m = 0; m < records.size(); ++m) {
+        const MatchRecord& r = records[m];
+        fprintf(out, "%zu,%llu,%s,%s,%.3f,%d,%d", m, (unsigned long long)r.seed, PolicyName(r.policy),
+                ResultName(r.result), r.lastGameTime, r.ticks, r.hidersTagged);
+        for (int s = 0; s < 3; ++s) fprintf(out, ",%.3f", r.hidingDwell[s]);
+        for (int s = 0; s < 3; ++s) fprintf(out, ",%.3f", r.seekingDwell[s]);
+        for (int i = 0; i < hiderCount; ++i) {
+            fprintf(out, ",%.3f,%d", r.hiderTaggedAt[i], r.hiderTagsLanded[i]);
+        }
+        fprintf(out, "\n");
+    }
+    fclose(out);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int matches = 1000;
+    uint64_t seed = 1;
+    int threads = -1;
+    std::vector<SeekerPolicy> policies(1, SeekerPolicy::SWEEP);
+    const char* outPath = "batch_results.csv";
+    SimConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            PrintUsage(stdout);
+            return 0;
+        }
+        bool takesValue = strcmp(arg, "--matches") == 0 || strcmp(arg, "--seed") == 0 ||
+                          strcmp(arg, "--threads") == 0 || strcmp(arg, "--policy") == 0 ||
+                          strcmp(arg, "--hiders") == 0 || strcmp(arg, "--tag-range") == 0 ||
+                          strcmp(arg, "--attack-cooldown") == 0 || strcmp(arg, "--seeking-duration") == 0 ||
+                          strcmp(arg, "--out") == 0;
+        if (!takesValue) {
+            fprintf(stderr, "Unknown option %s\n", arg);
+            PrintUsage(stderr);
+            return 1;
+        }
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (strcmp(arg, "--matches") == 0) matches = (int)strtol(value, nullptr, 10);
+        else if (strcmp(arg, "--seed") == 0) seed = strtoull(value, nullptr, 10);
+        else if (strcmp(arg, "--threads") == 0) threads = (int)strtol(value, nullptr, 10);
+        else if (strcmp(arg, "--policy") == 0) { if (!ParsePolicies(value, policies)) return 1; }
+        else if (strcmp(arg, "--hiders") == 0) config.hiderCount = (int)strtol(value, nullptr, 10);
+        else if (strcmp(arg, "--tag-range") == 0) config.tagRange = strtof(value, nullptr);
+        else if (strcmp(arg, "--attack-cooldown") == 0) config.hiderAttackCooldown = strtof(value, nullptr);
+        else if (strcmp(arg, "--seeking-duration") == 0) config.seekingPhaseDuration = strtof(value, nullptr);
+        else outPath = value;
+    }
+    if (matches <= 0 || config.hiderCount <= 0) {
+        fprintf(stderr, "--matches and --hiders must be positive\n");
+        return 1;
+    }
+
+    ThreadPool pool(threads > 0 ? threads - 1 : -1);
+    int slots = pool.GetWorkerCount() + 1;
+    std::vector<MatchRecord> records(matches);
+    std::atomic<int> nextMatch(0);
+
+    auto start = std::chrono::steady_clock::now();
+    // One slot per thread, each with its own world, pulling matches until none are left
+    pool.ParallelFor(slots, 1, [&](int begin, int end) {
+        for (int slot = begin; slot < end; ++slot) {
+            Simulation sim;
+            sim.config = config;
+            sim.LoadMap();
+            SeekerBot bot;
+            for (int m = nextMatch++; m < matches; m = nextMatch++) {
+                bot.policy = policies[m % policies.size()];
+                PlayMatch(sim, bot, RandomStream(seed, (uint64_t)m).NextU64(), records[m]);
+            }
+        }
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!WriteResults(outPath, records, config.hiderCount)) return 1;
+
+    int results[4] = {0};
+    for (const MatchRecord& r : records) results[(int)r.result]++;
+    printf("%d matches on %d threads in %.2fs, results in %s\n", matches, slots, seconds, outPath);
+    printf("seeker won %d, seeker tagged %d, time up %d\n", results[(int)MatchResult::SEEKER_WON],
+           results[(int)MatchResult::SEEKER_TAGGED], results[(int)MatchResult::TIME_UP]);
+    return 0;
+}
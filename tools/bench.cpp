@@ -0,0 +1,369 @@
+// hidenseek-bench: times the simulation hot paths so a change can be checked for speedups or
+// regressions before it is merged.
+//
+// Usage: hidenseek-bench [--filter <text>] [--min-time <seconds>] [--json <file>]
+//
+// Every benchmark runs until it has used at least --min-time (default 0.2s) and reports
+// nanoseconds and heap allocations per call. Names carry their parameters, e.g.
+// "HiderBatch::Update/EVADING/hiders:1000", and --filter keeps those containing the text.
+// The JSON file uses Google Benchmark's layout (real_time and cpu_time in ns, both wall time
+// here), so its compare.py can diff two runs; allocations are in an extra allocs_per_op field.
+//
+// Scenarios are generated from fixed seeds and don't read map.hsmap, so runs on different
+// machines or checkouts measure the same work.
+#include "simulation.h"
+#include "spatial_hash.h"
+#include "random.h"
+#include "constants.h"
+#include <atomic>  // For the allocation counter
+#include <chrono>  // For steady_clock
+#include <cstdio>  // For printf, fopen
+#include <cstdlib> // For malloc, free, strtod
+#include <cstring> // For strcmp, strstr
+#include <new>     // For std::bad_alloc
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<long long> allocationCount(0);
+
+} // namespace
+
+// Every heap allocation in the process goes through these, which is how allocs/op is counted.
+// The array and sized forms forward here by default.
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* block = malloc(size ? size : 1);
+    if (!block) throw std::bad_alloc();
+    return block;
+}
+
+void operator delete(void* block) noexcept {
+    free(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+    free(block);
+}
+
+namespace {
+
+const uint64_t BENCH_SEED = 12345;
+const int QUERY_POINT_COUNT = 4096; // Power of two, ops cycle through them with a mask
+const int OBSTACLE_COUNTS[] = {11, 100, 1000, 5000}; // 11 is the built-in house layout
+const int HIDER_COUNTS[] = {5, 100, 1000, 10000};
+const int GENERATED_WORLD_SIZE = 4096; // Square world for the generated obstacle layouts
+
+volatile long long benchSink; // Op results land here so the compiler can't drop the calls
+
+struct BenchResult {
+    std::string name;
+    long long iterations;
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+class BenchRunner {
+public:
+    double minTime;
+    const char* filter;
+    std::vector<BenchResult> results;
+
+    BenchRunner() : minTime(0.2), filter(nullptr) {}
+
+    bool Wanted(const std::string& name) const { return !filter || strstr(name.c_str(), filter); }
+
+    // For ops that leave the world as they found it: op(i) is called in batches that grow
+    // until one takes minTime
+    template <typename Op>
+    void Run(const std::string& name, Op op) {
+        if (!Wanted(name)) return;
+        benchSink = benchSink + op(0); // Warm up caches before timing
+
+        long long iterations = 1;
+        for (;;) {
+            long long allocationsBefore = allocationCount.load();
+            auto start = std::chrono::steady_clock::now();
+            long long sum = 0;
+            for (long long i = 0; i < iterations; ++i) sum += op((int)i);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            long long allocations = allocationCount.load() - allocationsBefore;
+            benchSink = benchSink + sum;
+
+            if (seconds >= minTime || iterations >= (1ll << 32)) {
+                Report(name, iterations, seconds, allocations);
+                return;
+            }
+            double scale = seconds > 0 ? minTime / seconds * 1.2 : 10.0;
+            long long next = (long long)(iterations * (scale < 10.0 ? scale : 10.0));
+            iterations = next > iterations ? next : iterations * 2;
+        }
+    }
+
+    // For ops that change the world: setup() puts it back before every call and isn't timed
+    template <typename Setup, typename Op>
+    void RunWithSetup(const std::string& name, Setup setup, Op op) {
+        if (!Wanted(name)) return;
+        setup();
+        benchSink = benchSink + op(0);
+
+        long long iterations = 0;
+        long long allocations = 0;
+        double seconds = 0.0;
+        auto wallStart = std::chrono::steady_clock::now();
+        while (seconds < minTime) {
+            setup();
+            long long allocationsBefore = allocationCount.load();
+            auto start = std::chrono::steady_clock::now();
+            benchSink = benchSink + op((int)iterations);
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            allocations += allocationCount.load() - allocationsBefore;
+            iterations++;
+            // Don't let a slow setup hold up the whole run
+            if (std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count() > minTime * 20) break;
+        }
+        Report(name, iterations, seconds, allocations);
+    }
+
+    bool WriteJson(const char* path, const char* executable) const {
+        FILE* out = fopen(path, "w");
+        if (!out) return false;
+        fprintf(out, "{\n  \"context\": {\n    \"executable\": \"%s\",\n    \"min_time\": %g\n  },\n", executable, minTime);
+        fprintf(out, "  \"benchmarks\": [\n");
+        for (size_t b = 0; b < results.size(); ++b) {
+            const BenchResult& r = results[b];
+            fprintf(out, "    {\"name\": \"%s\", \"run_name\": \"%s\", \"run_type\": \"iteration\", "
+                         "\"iterations\": %lld, \"real_time\": %.3f, \"cpu_time\": %.3f, \"time_unit\": \"ns\", "
+                         "\"allocs_per_op\": %.4f}%s\n",
+                    r.name.c_str(), r.name.c_str(), r.iterations, r.nsPerOp, r.nsPerOp, r.allocsPerOp,
+                    b + 1 < results.size() ? "," : "");
+        }
+        fprintf(out, "  ]\n}\n");
+        return fclose(out) == 0;
+    }
+
+private:
+    void Report(const std::string& name, long long iterations, double seconds, long long allocations) {
+        BenchResult result = {name, iterations, seconds * 1e9 / iterations, (double)allocations / iterations};
+        results.push_back(result);
+        printf("%-52s %14.1f ns/op %10.3f allocs/op %12lld iters\n", name.c_str(), result.nsPerOp,
+               result.allocsPerOp, iterations);
+        fflush(stdout);
+    }
+};
+
+std::string Name(const char* base, const char* param, int value, const char* suffix = nullptr) {
+    char name[128];
+    if (suffix) {
+        snprintf(name, sizeof(name), "%s/%s:%d/%s", base, param, value, suffix);
+    } else {
+        snprintf(name, sizeof(name), "%s/%s:%d", base, param, value);
+    }
+    return name;
+}
+
+std::vector<Vector2> RandomPoints(RandomStream& random, int count, float width, float height) {
+    std::vector<Vector2> points(count);
+    for (Vector2& point : points) point = {random.NextFloat() * width, random.NextFloat() * height};
+    return points;
+}
+
+// The house layout for 11 obstacles, otherwise small crates scattered over a large square world
+void BuildObstacleMap(Map& map, int obstacleCount) {
+    if (obstacleCount <= 11) {
+        map.BuildDefaultLayout();
+        return;
+    }
+
+    RandomStream random(BENCH_SEED, (uint64_t)obstacleCount);
+    std::vector<Rectangle> obstacles(obstacleCount);
+    for (Rectangle& obstacle : obstacles) {
+        obstacle.width = (float)(10 + random.NextInt(31));
+        obstacle.height = (float)(10 + random.NextInt(31));
+        obstacle.x = (float)random.NextInt(GENERATED_WORLD_SIZE - (int)obstacle.width);
+        obstacle.y = (float)random.NextInt(GENERATED_WORLD_SIZE - (int)obstacle.height);
+    }
+    std::vector<Vector2> hidingSpots = RandomPoints(random, 64, (float)GENERATED_WORLD_SIZE, (float)GENERATED_WORLD_SIZE);
+    float padding = PLAYER_RADIUS + 50.0f;
+    float far = GENERATED_WORLD_SIZE - padding;
+    std::vector<Vector2> spawnPoints = {{padding, padding}, {far, padding}, {padding, far}, {far, far}};
+    map.BuildLayout(GENERATED_WORLD_SIZE, GENERATED_WORLD_SIZE, obstacles, hidingSpots, spawnPoints);
+}
+
+void BenchMapQueries(BenchRunner& runner) {
+    for (int obstacleCount : OBSTACLE_COUNTS) {
+        std::string baked = Name("Map::IsPositionValid", "obstacles", obstacleCount, "baked");
+        std::string unbaked = Name("Map::IsPositionValid", "obstacles", obstacleCount, "unbaked");
+        std::string flee = Name("FleeField::Update", "obstacles", obstacleCount);
+        if (!runner.Wanted(baked) && !runner.Wanted(unbaked) && !runner.Wanted(flee)) continue;
+
+        Map map;
+        BuildObstacleMap(map, obstacleCount);
+        RandomStream random(BENCH_SEED, 1);
+        std::vector<Vector2> points = RandomPoints(random, QUERY_POINT_COUNT, (float)map.width, (float)map.height);
+
+        // HIDER_RADIUS has a baked collision grid; other radii scan the obstacle list
+        runner.Run(baked, [&](int i) { return (int)map.IsPositionValid(points[i & (QUERY_POINT_COUNT - 1)], HIDER_RADIUS); });
+        runner.Run(unbaked, [&](int i) { return (int)map.IsPositionValid(points[i & (QUERY_POINT_COUNT - 1)], 7.0f); });
+
+        // A full rebuild, as when the seeker crosses into another nav cell
+        FleeField fleeField;
+        runner.RunWithSetup(flee, [&]() { fleeField.Reset(); }, [&](int i) {
+            fleeField.Update(map.GetPathfinder(), points[i & (QUERY_POINT_COUNT - 1)]);
+            return fleeField.sourceCell;
+        });
+    }
+}
+
+void BenchVisionChecks(BenchRunner& runner) {
+    RandomStream random(BENCH_SEED, 2);
+    std::vector<Vector2> targets = RandomPoints(random, QUERY_POINT_COUNT, (float)SCREEN_WIDTH, (float)SCREEN_HEIGHT);
+
+    HiderBatch hiders;
+    hiders.Resize(QUERY_POINT_COUNT, BENCH_SEED);
+    for (int i = 0; i < QUERY_POINT_COUNT; ++i) {
+        hiders.Front().position[i] = {random.NextFloat() * SCREEN_WIDTH, random.NextFloat() * SCREEN_HEIGHT};
+        hiders.Front().rotation[i] = random.NextFloat() * 360.0f;
+    }
+    runner.Run("HiderBatch::IsInVision", [&](int i) {
+        int hider = i & (QUERY_POINT_COUNT - 1);
+        return (int)HiderBatch::IsInVision(hiders.Front(), hider, targets[(hider * 7 + 1) & (QUERY_POINT_COUNT - 1)]);
+    });
+
+    Player player;
+    player.Init({SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f});
+    runner.Run("Player::IsInVisionCone", [&](int i) {
+        return (int)player.IsInVisionCone(targets[i & (QUERY_POINT_COUNT - 1)], PLAYER_VISION_CONE_ANGLE, PLAYER_VISION_RADIUS);
+    });
+}
+
+// Puts every untagged hider into one FSM state, with a hiding spot to head for
+void ForceState(Simulation& sim, int state) {
+    HiderState& s = sim.hiders.Front();
+    ArrayView<Vector2> spots = sim.gameMap.GetHidingSpots();
+    for (int i = 0; i < sim.hiders.count; ++i) {
+        if (s.isTagged[i]) continue;
+        if (sim.currentPhase == GamePhase::HIDING) {
+            s.hidingState[i] = (HiderHidingFSMState)state;
+            if (!spots.empty()) s.targetHidingSpot[i] = spots[i % spots.size()];
+        } else {
+            s.seekingState[i] = (HiderSeekingFSMState)state;
+        }
+    }
+}
+
+void BenchHiders(BenchRunner& runner) {
+    const float tickDelta = 1.0f / SIM_TICK_RATE;
+    const char* hidingStates[] = {"SCOUTING", "MOVING_TO_HIDING_SPOT", "HIDING"};
+    const char* seekingStates[] = {"IDLING", "EVADING", "ATTACKING"};
+
+    for (int hiderCount : HIDER_COUNTS) {
+        std::string prefix = Name("", "hiders", hiderCount);
+        // Building the world takes a while at high counts, so skip it when nothing here is wanted
+        std::vector<std::string> names = {Name("HiderBatch::IsSpotTaken", "hiders", hiderCount),
+                                          Name("Player::Update", "hiders", hiderCount),
+                                          Name("Simulation::Tick", "hiders", hiderCount, "hiding"),
+                                          Name("Simulation::Tick", "hiders", hiderCount, "seeking")};
+        for (int state = 0; state < 3; ++state) {
+            names.push_back(std::string("HiderBatch::Update/") + hidingStates[state] + prefix);
+            names.push_back(std::string("HiderBatch::Update/") + hidingStates[state] + "/replan" + prefix);
+            names.push_back(std::string("HiderBatch::Update/") + seekingStates[state] + prefix);
+            names.push_back(std::string("HiderBatch::Update/") + seekingStates[state] + "/replan" + prefix);
+        }
+        bool anyWanted = false;
+        for (const std::string& name : names) anyWanted = anyWanted || runner.Wanted(name);
+        if (!anyWanted) continue;
+
+        // Hiding phase a second in, so hiders have claimed spots
+        Simulation sim;
+        sim.gameMap.BuildDefaultLayout();
+        sim.config.hiderCount = hiderCount;
+        sim.Reset(BENCH_SEED);
+        for (int tick = 0; tick < (int)SIM_TICK_RATE; ++tick) sim.Tick(tickDelta, SeekerInput());
+
+        std::vector<unsigned char> snapshot(sim.GetSnapshotSize());
+        auto updateHiders = [&](int) {
+            sim.hiders.Update(tickDelta, sim.currentPhase, sim.player, sim.gameMap, sim.hiderHash, sim.fleeField);
+            return sim.hiders.tagEvents;
+        };
+        ArrayView<Vector2> spots = sim.gameMap.GetHidingSpots();
+        runner.Run(Name("HiderBatch::IsSpotTaken", "hiders", hiderCount), [&](int i) {
+            return (int)HiderBatch::IsSpotTaken(i % hiderCount, spots[i % spots.size()], sim.hiderHash, sim.player);
+        });
+
+        sim.SaveSnapshot(snapshot.data());
+        runner.RunWithSetup(Name("Simulation::Tick", "hiders", hiderCount, "hiding"),
+                            [&]() { sim.LoadSnapshot(snapshot.data()); },
+                            [&](int) { sim.Tick(tickDelta, SeekerInput()); return sim.tickCount; });
+        for (int state = 0; state < 3; ++state) {
+            std::vector<unsigned char> stateSnapshot(sim.GetSnapshotSize());
+            sim.LoadSnapshot(snapshot.data());
+            ForceState(sim, state);
+            // Straight after ForceState the cached paths lead to the old goals, so every update replans
+            sim.SaveSnapshot(stateSnapshot.data());
+            runner.RunWithSetup(std::string("HiderBatch::Update/") + hidingStates[state] + "/replan" + prefix,
+                                [&]() { sim.LoadSnapshot(stateSnapshot.data()); }, updateHiders);
+            // One update plans the new paths, so the steady benchmark times the ticks that follow
+            updateHiders(0);
+            sim.SaveSnapshot(stateSnapshot.data());
+            runner.RunWithSetup(std::string("HiderBatch::Update/") + hidingStates[state] + prefix,
+                                [&]() { sim.LoadSnapshot(stateSnapshot.data()); }, updateHiders);
+        }
+
+        // Seeking phase, with the seeker standing still so the flee field stays built
+        sim.LoadSnapshot(snapshot.data());
+        sim.Tick(tickDelta, SeekerInput(SEEKER_INPUT_SKIP_HIDING));
+        sim.Tick(tickDelta, SeekerInput());
+        sim.SaveSnapshot(snapshot.data());
+        auto restoreSeeking = [&](const std::vector<unsigned char>& from) {
+            sim.LoadSnapshot(from.data());
+            sim.fleeField.Update(sim.gameMap.GetPathfinder(), sim.player.position);
+        };
+
+        runner.RunWithSetup(Name("Player::Update", "hiders", hiderCount), [&]() { restoreSeeking(snapshot); }, [&](int) {
+            sim.player.Update(tickDelta, SeekerInput(), sim.gameMap, sim.hiders, sim.hiderHash);
+            return (int)sim.player.showAlert;
+        });
+        runner.RunWithSetup(Name("Simulation::Tick", "hiders", hiderCount, "seeking"), [&]() { restoreSeeking(snapshot); },
+                            [&](int) { sim.Tick(tickDelta, SeekerInput()); return sim.tickCount; });
+        for (int state = 0; state < 3; ++state) {
+            std::vector<unsigned char> stateSnapshot(sim.GetSnapshotSize());
+            restoreSeeking(snapshot);
+            ForceState(sim, state);
+            sim.SaveSnapshot(stateSnapshot.data());
+            runner.RunWithSetup(std::string("HiderBatch::Update/") + seekingStates[state] + "/replan" + prefix,
+                                [&]() { restoreSeeking(stateSnapshot); }, updateHiders);
+            updateHiders(0);
+            sim.SaveSnapshot(stateSnapshot.data());
+            runner.RunWithSetup(std::string("HiderBatch::Update/") + seekingStates[state] + prefix,
+                                [&]() { restoreSeeking(stateSnapshot); }, updateHiders);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchRunner runner;
+    const char* jsonPath = nullptr;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--filter") == 0) runner.filter = argv[i + 1];
+        else if (strcmp(argv[i], "--min-time") == 0) runner.minTime = strtod(argv[i + 1], nullptr);
+        else if (strcmp(argv[i], "--json") == 0) jsonPath = argv[i + 1];
+        else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    BenchMapQueries(runner);
+    BenchVisionChecks(runner);
+    BenchHiders(runner);
+
+    if (jsonPath && !runner.WriteJson(jsonPath, argv[0])) {
+        fprintf(stderr, "Could not write '%s'\n", jsonPath);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+// hidenseek-mapbake: bakes a map layout into the .hsmap file the game memory-maps at startup.
+//
+// Usage: hidenseek-mapbake [layout.txt] [output.hsmap]
+//
+// Without a layout file the built-in house layout is baked. A layout file is plain text,
+// one entry per line ('#' starts a comment):
+//     size <width> <height>
+//     obstacle <x> <y> <width> <height>
+//     spot <x> <y>
+//     spawn <x> <y>
+#include "map.h"
+#include "map_file.h"
+#include "constants.h"
+#include <cstdio>  // For fopen, fgets, printf
+#include <cstring> // For strcmp
+#include <vector>
+
+namespace {
+
+bool ReadLayout(const char* path, Map& map) {
+    FILE* in = fopen(path, "r");
+    if (!in) {
+        fprintf(stderr, "Could not open layout '%s'\n", path);
+        return false;
+    }
+
+    int worldWidth = SCREEN_WIDTH;
+    int worldHeight = SCREEN_HEIGHT;
+    std::vector<Rectangle> obstacles;
+    std::vector<Vector2> hidingSpots;
+    std::vector<Vector2> spawnPoints;
+
+    char line[256];
+    int lineNumber = 0;
+    bool ok = true;
+    while (fgets(line, sizeof(line), in)) {
+        lineNumber++;
+        char keyword[32] = {0};
+        float a, b, c, d;
+        if (sscanf(line, " %31s", keyword) != 1 || keyword[0] == '#') continue;
+
+        if (strcmp(keyword, "size") == 0 && sscanf(line, " %*s %f %f", &a, &b) == 2) {
+            worldWidth = (int)a;
+            worldHeight = (int)b;
+        } else if (strcmp(keyword, "obstacle") == 0 && sscanf(line, " %*s %f %f %f %f", &a, &b, &c, &d) == 4) {
+            obstacles.push_back({a, b, c, d});
+        } else if (strcmp(keyword, "spot") == 0 && sscanf(line, " %*s %f %f", &a, &b) == 2) {
+            hidingSpots.push_back({a, b});
+        } else if (strcmp(keyword, "spawn") == 0 && sscanf(line, " %*s %f %f", &a, &b) == 2) {
+            spawnPoints.push_back({a, b});
+        } else {
+            fprintf(stderr, "%s:%d: unrecognised line\n", path, lineNumber);
+            ok = false;
+        }
+    }
+    fclose(in);
+
+    if (ok) map.BuildLayout(worldWidth, worldHeight, obstacles, hidingSpots, spawnPoints);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* layoutPath = argc > 2 ? argv[1] : nullptr;
+    const char* outputPath = argc > 2 ? argv[2] : (argc > 1 ? argv[1] : MAP_FILE_PATH);
+
+    Map map;
+    if (layoutPath) {
+        if (!ReadLayout(layoutPath, map)) return 1;
+    } else {
+        map.BuildDefaultLayout();
+    }
+
+    if (!MapFile::Write(map, outputPath)) {
+        fprintf(stderr, "Could not write '%s'\n", outputPath);
+        return 1;
+    }
+
+    printf("Wrote %s: %dx%d, %d obstacles, %d hiding spots, %d spawn points\n", outputPath, map.width, map.height,
+           (int)map.obstacles.size(), (int)map.hidingSpots.size(), (int)map.spawnPoints.size());
+    return 0;
+}
@@ -0,0 +1,90 @@
+// hidenseek-sim: runs matches headless, with no window, GPU or audio, as fast as the CPU allows.
+//
+// Usage: hidenseek-sim [matches] [seed]
+//        hidenseek-sim --replay <file.hsreplay>
+//
+// Uses map.hsmap from the working directory if there is one, otherwise the built-in layout.
+// Every match is seeded from the one before it, the same way the game seeds restarts, so a
+// run is reproduced exactly by its first seed. The seeker sends no input.
+//
+// With --replay it plays one recorded match instead and checks that it ends the way the
+// recording did.
+#include "simulation.h"
+#include "replay.h"
+#include "random.h"
+#include "constants.h"
+#include <chrono>  // For steady_clock
+#include <cstdio>  // For printf
+#include <cstdlib> // For strtol, strtoull
+#include <cstring> // For strcmp
+
+namespace {
+
+int PlayReplay(const char* path) {
+    Replay replay;
+    if (!replay.Load(path)) {
+        fprintf(stderr, "Could not load replay '%s' (missing, invalid or recorded at another tick rate)\n", path);
+        return 1;
+    }
+
+    Simulation sim;
+    sim.config = replay.config;
+    sim.LoadMap();
+    if (!replay.IsForMap(sim.gameMap.layoutHash)) {
+        fprintf(stderr, "Replay '%s' was recorded on a different map\n", path);
+        return 1;
+    }
+    sim.Reset(replay.seed);
+
+    ReplaySeekerController seeker;
+    seeker.Start(&replay);
+    const float tickDelta = 1.0f / SIM_TICK_RATE;
+    while (!sim.IsOver() && !seeker.IsFinished()) {
+        sim.Tick(tickDelta, seeker.NextInput(sim));
+    }
+
+    printf("seed %llu, %d ticks (%zu bytes of input), result %d, seeking time %.2fs, %d hiders left\n",
+           (unsigned long long)replay.seed, sim.tickCount, replay.inputs.size(), (int)sim.result,
+           sim.lastGameTime, sim.hidersRemaining);
+    if ((int)sim.result != replay.result || sim.tickCount != replay.tickCount) {
+        printf("MISMATCH: recorded result %d at tick %d\n", replay.result, replay.tickCount);
+        return 2;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 2 && strcmp(argv[1], "--replay") == 0) {
+        return PlayReplay(argv[2]);
+    }
+
+    int matches = argc > 1 ? (int)strtol(argv[1], nullptr, 10) : 100;
+    uint64_t seed = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1;
+
+    Simulation sim;
+    sim.LoadMap();
+
+    const float tickDelta = 1.0f / SIM_TICK_RATE;
+    int results[4] = {0};
+    long long totalTicks = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int match = 0; match < matches; ++match) {
+        sim.Reset(seed);
+        while (!sim.IsOver()) {
+            sim.Tick(tickDelta, SeekerInput());
+        }
+        results[(int)sim.result]++;
+        totalTicks += sim.tickCount;
+        seed = RandomStream(seed, RANDOM_STREAM_NEXT_MATCH).NextU64();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%d matches, %lld ticks in %.2fs (%.0f ticks/s)\n", matches, totalTicks, seconds,
+           seconds > 0 ? totalTicks / seconds : 0.0);
+    printf("seeker won %d, seeker tagged %d, time up %d\n", results[(int)MatchResult::SEEKER_WON],
+           results[(int)MatchResult::SEEKER_TAGGED], results[(int)MatchResult::TIME_UP]);
+    return 0;
+}